@@ -1,8 +1,204 @@
 // 6806021410124 ธนวิชญ์ ดอบุตร
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
 using namespace std;
 
-int main() {
+// Batch mode: convert a whole file (or stdin) of Fahrenheit readings
+//   F2C --batch [input|-] [-o output] [-t threads]
+//   F2C --bench [count]      compare batch path with the cin/cout loop
+const size_t CHUNK_SIZE = 16 << 20;       // input read per step
+const size_t PARALLEL_MIN = 1 << 20;      // smaller chunks stay on one thread
+
+// c = (f - 32) * 5 / 9, same operation order as the interactive path
+void toCelsius(const double* f, double* c, size_t n) {
+    size_t i = 0;
+#if defined(__AVX__)
+    const __m256d k32 = _mm256_set1_pd(32.0), k5 = _mm256_set1_pd(5.0), k9 = _mm256_set1_pd(9.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(f + i);
+        _mm256_storeu_pd(c + i, _mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(v, k32), k5), k9));
+    }
+#elif defined(__SSE2__)
+    const __m128d k32 = _mm_set1_pd(32.0), k5 = _mm_set1_pd(5.0), k9 = _mm_set1_pd(9.0);
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(f + i);
+        _mm_storeu_pd(c + i, _mm_div_pd(_mm_mul_pd(_mm_sub_pd(v, k32), k5), k9));
+    }
+#endif
+    for (; i < n; i++) c[i] = (f[i] - 32) * 5.0 / 9.0;
+}
+
+inline bool isSep(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t' || ch == ',';
+}
+
+// parse numbers in [b, e), convert, and append one result per line to out
+size_t convertRange(const char* b, const char* e, string &out, size_t &bad) {
+    vector<double> vals;
+    vals.reserve((e - b) / 4);
+    while (b < e) {
+        while (b < e && isSep(*b)) b++;
+        if (b == e) break;
+        double v;
+        auto r = from_chars(b, e, v);
+        if (r.ec == errc() && (r.ptr == e || isSep(*r.ptr))) {
+            vals.push_back(v);
+            b = r.ptr;
+        } else {
+            bad++;
+            while (b < e && !isSep(*b)) b++;
+        }
+    }
+    toCelsius(vals.data(), vals.data(), vals.size());
+    out.reserve(out.size() + vals.size() * 12);
+    char tmp[64];
+    for (double c : vals) {
+        auto r = to_chars(tmp, tmp + sizeof(tmp), c, chars_format::general, 6); // like cout default
+        out.append(tmp, r.ptr);
+        out += '\n';
+    }
+    return vals.size();
+}
+
+// convert one chunk, split on separators across threads when it is large
+size_t convertChunk(const char* b, const char* e, unsigned threads, vector<string> &outs, size_t &bad) {
+    size_t len = e - b;
+    unsigned parts = (len >= PARALLEL_MIN && threads > 1) ? threads : 1;
+    vector<const char*> cut(parts + 1);
+    cut[0] = b;
+    cut[parts] = e;
+    for (unsigned i = 1; i < parts; i++) {
+        const char* p = b + len * i / parts;
+        if (p < cut[i - 1]) p = cut[i - 1];
+        while (p < e && !isSep(*p)) p++;
+        cut[i] = p;
+    }
+    outs.assign(parts, string());
+    vector<size_t> counts(parts, 0), bads(parts, 0);
+    vector<thread> pool;
+    for (unsigned i = 1; i < parts; i++)
+        pool.emplace_back([&, i] { counts[i] = convertRange(cut[i], cut[i + 1], outs[i], bads[i]); });
+    counts[0] = convertRange(cut[0], cut[1], outs[0], bads[0]);
+    for (auto &t : pool) t.join();
+    size_t total = 0;
+    for (unsigned i = 0; i < parts; i++) { total += counts[i]; bad += bads[i]; }
+    return total;
+}
+
+// stream input in chunks, carrying a partial trailing number to the next chunk
+size_t runBatch(FILE* in, FILE* out, unsigned threads, size_t &bad) {
+    vector<char> buf(CHUNK_SIZE);
+    vector<string> outs;
+    size_t carry = 0, total = 0;
+    while (true) {
+        size_t got = fread(buf.data() + carry, 1, buf.size() - carry, in);
+        size_t have = carry + got;
+        if (have == 0) break;
+        size_t end = have;
+        if (got > 0) { // keep the last unfinished token for the next read
+            while (end > 0 && !isSep(buf[end - 1])) end--;
+            if (end == 0) { buf.resize(buf.size() * 2); carry = have; continue; }
+        }
+        total += convertChunk(buf.data(), buf.data() + end, threads, outs, bad);
+        for (auto &s : outs) fwrite(s.data(), 1, s.size(), out);
+        carry = have - end;
+        memmove(buf.data(), buf.data() + end, carry);
+        if (got == 0) break;
+    }
+    return total;
+}
+
+double secondsSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int batchMain(int argc, char* argv[]) {
+    string inName = "-", outName = "-";
+    unsigned threads = thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    for (int i = 2; i < argc; i++) {
+        string a = argv[i];
+        if (a == "-o" && i + 1 < argc) outName = argv[++i];
+        else if (a == "-t" && i + 1 < argc) threads = max(1, atoi(argv[++i]));
+        else inName = a;
+    }
+    FILE* in = inName == "-" ? stdin : fopen(inName.c_str(), "rb");
+    FILE* out = outName == "-" ? stdout : fopen(outName.c_str(), "wb");
+    if (!in || !out) { cerr << "File could not opened." << endl; return 1; }
+    static char outBuf[1 << 20];
+    setvbuf(out, outBuf, _IOFBF, sizeof(outBuf));
+
+    size_t bad = 0;
+    auto t0 = chrono::steady_clock::now();
+    size_t n = runBatch(in, out, threads, bad);
+    fflush(out);
+    double sec = secondsSince(t0);
+    cerr << "converted " << n << " values in " << sec << " s ("
+         << (sec > 0 ? n / sec : 0) << " values/s, " << threads << " threads)";
+    if (bad) cerr << ", skipped " << bad << " bad tokens";
+    cerr << endl;
+    if (in != stdin) fclose(in);
+    if (out != stdout) fclose(out);
+    return 0;
+}
+
+int benchMain(int argc, char* argv[]) {
+    size_t n = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000000;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    mt19937 rng(42);
+    uniform_real_distribution<double> dist(-40.0, 140.0);
+    string input;
+    char tmp[64];
+    for (size_t i = 0; i < n; i++) {
+        auto r = to_chars(tmp, tmp + sizeof(tmp), dist(rng), chars_format::fixed, 2);
+        input.append(tmp, r.ptr);
+        input += '\n';
+    }
+
+    // per-value stream loop, as in the interactive path
+    auto t0 = chrono::steady_clock::now();
+    istringstream sin(input);
+    ostringstream sout;
+    double fahrenheit, celsius;
+    while (sin >> fahrenheit) {
+        celsius = (fahrenheit - 32) * 5.0 / 9.0;
+        sout << celsius << "\n";
+    }
+    double loopSec = secondsSince(t0);
+
+    t0 = chrono::steady_clock::now();
+    vector<string> outs;
+    size_t bad = 0, done = 0;
+    for (size_t off = 0; off < input.size();) {
+        size_t end = min(input.size(), off + CHUNK_SIZE);
+        while (end < input.size() && !isSep(input[end])) end++;
+        done += convertChunk(input.data() + off, input.data() + end, threads, outs, bad);
+        off = end;
+    }
+    double batchSec = secondsSince(t0);
+
+    cout << "values        : " << n << "\n";
+    cout << "cin/cout loop : " << n / loopSec << " values/s\n";
+    cout << "batch         : " << done / batchSec << " values/s (" << threads << " threads)\n";
+    cout << "speedup       : " << loopSec / batchSec << "x" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--batch") return batchMain(argc, argv);
+    if (argc > 1 && string(argv[1]) == "--bench") return benchMain(argc, argv);
+
     double fahrenheit, celsius;
 
     
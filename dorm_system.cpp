@@ -14,6 +14,28 @@
 #include <ctime>
 #include <set>
 #include <cmath>
+#include <tuple>
+#include <string_view>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <iterator>
+#include <array>
+#include <limits>
+#include <cctype>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <atomic>
+#include <future>
+#include <deque>
+#include <filesystem>
+#include <chrono>
+#include <random>
+#include <queue>
 
 using namespace std;
 
@@ -25,25 +47,28 @@ vector<string> split(const string &s, char delim='|'){
     while(getline(ss, token, delim)) out.push_back(token);
     return out;
 }
-string join(const vector<string>& parts, char delim='|'){
-    string out;
-    for(size_t i=0;i<parts.size();++i){
-        out += parts[i];
-        if(i+1<parts.size()) out += delim;
-    }
-    return out;
-}
 string trim(const string &s){
     size_t a = s.find_first_not_of(" \t\r\n");
     if(a==string::npos) return "";
     size_t b = s.find_last_not_of(" \t\r\n");
     return s.substr(a, b-a+1);
 }
+// Menu choice; only end of input counts as 0 (back/exit). Anything that is
+// not a number is dropped with the rest of its line and asked again.
+int readChoice(){
+    int c;
+    while(!(cin >> c)){
+        if(cin.eof()) return 0;
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Please enter a number.\nChoose: ";
+    }
+    return c;
+}
 string genID(const string &prefix){
-    static int seq = 0;
-    seq++;
+    static atomic<int> seq{0};
     stringstream ss;
-    ss << prefix << (time(nullptr) % 100000) << seq;
+    ss << prefix << (time(nullptr) % 100000) << ++seq;
     return ss.str();
 }
 
@@ -54,8 +79,43 @@ const string CONTRACT_FILE = "Contract.dat";
 const string UTILITY_FILE = "Utility.dat";
 const string INVOICE_FILE = "Invoice.dat";
 const string PAYMENT_FILE = "Payment.dat";
+const string EXPIRED_FILE = "Expired.dat";
 const string ADMIN_FILE = "Admin.dat";
 const string REPORT_FILE = "report.txt";
+const string GROUP_REPORT_FILE = "group_report.txt";
+
+// ---------- Buildings ----------
+// Each building keeps its own tables in buildings/<name>/. The empty name is
+// the original single-building layout in the working directory. Admin.dat is
+// shared by all buildings.
+const string BUILDINGS_DIR = "buildings";
+string currentBuilding = "";
+
+string shardPath(const string &building, const string &file){
+    return building.empty() ? file : BUILDINGS_DIR + "/" + building + "/" + file;
+}
+string dataPath(const string &file){ return shardPath(currentBuilding, file); }
+
+// Building names become directory names, so no separators or dots.
+bool validBuildingName(const string &name){
+    return name.find_first_of("/\\.") == string::npos;
+}
+
+// The default building ("") is listed whenever it holds any table, or when
+// there are no named buildings yet (single-building setup).
+vector<string> listBuildings(){
+    vector<string> out;
+    error_code ec;
+    for(auto &e: filesystem::directory_iterator(BUILDINGS_DIR, ec))
+        if(e.is_directory()) out.push_back(e.path().filename().string());
+    sort(out.begin(), out.end());
+    bool rootHasData = false;
+    for(auto *f: {&ROOM_FILE, &TENANT_FILE, &CONTRACT_FILE, &UTILITY_FILE, &INVOICE_FILE, &PAYMENT_FILE})
+        rootHasData = rootHasData || filesystem::exists(*f, ec);
+    if(out.empty() || rootHasData) out.insert(out.begin(), "");
+    return out;
+}
+string buildingLabel(const string &b){ return b.empty() ? "(default)" : b; }
 
 // ---------- Structs ----------
 struct Room {
@@ -121,129 +181,980 @@ struct Admin {
     string password;
 };
 
-// ---------- Load / Save ----------
-vector<Room> loadRooms(){
-    vector<Room> v;
-    ifstream f(ROOM_FILE);
-    string line;
-    while(getline(f, line)){
-        if(line.empty()) continue;
-        auto p = split(line);
-        if(p.size()>=3) v.push_back(Room{p[0], p[1], p[2]});
-    }
-    return v;
+// A contract end that has already been announced and acted on.
+struct ExpiredContract {
+    string contractID;
+    string endDate;
+};
+
+// ---------- Table Schema ----------
+// Every table is described once by a Schema<T> specialisation listing its
+// fields in file order. Table<T> expands that list at compile time into the
+// parse/format code for the '|' text files and for a compact binary form,
+// so adding a column is a single line in the schema.
+template<class T, class V>
+struct FieldDesc {
+    const char* name;
+    V T::*member;
+};
+template<class T, class V>
+constexpr FieldDesc<T,V> field(const char* name, V T::*member){ return FieldDesc<T,V>{name, member}; }
+
+template<class T> struct Schema;
+
+template<> struct Schema<Room> {
+    static constexpr auto fields = make_tuple(
+        field("roomNo", &Room::roomNo),
+        field("type", &Room::type),
+        field("status", &Room::status));
+};
+template<> struct Schema<Tenant> {
+    static constexpr auto fields = make_tuple(
+        field("tenantID", &Tenant::tenantID),
+        field("name", &Tenant::name),
+        field("phone", &Tenant::phone),
+        field("citizenID", &Tenant::citizenID),
+        field("birthDate", &Tenant::birthDate),
+        field("address", &Tenant::address),
+        field("roomNo", &Tenant::roomNo));
+};
+template<> struct Schema<Contract> {
+    static constexpr auto fields = make_tuple(
+        field("contractID", &Contract::contractID),
+        field("tenantID", &Contract::tenantID),
+        field("roomNo", &Contract::roomNo),
+        field("startDate", &Contract::startDate),
+        field("endDate", &Contract::endDate),
+        field("roomPrice", &Contract::roomPrice),
+        field("internetFee", &Contract::internetFee));
+};
+template<> struct Schema<Utility> {
+    static constexpr auto fields = make_tuple(
+        field("roomNo", &Utility::roomNo),
+        field("month", &Utility::month),
+        field("year", &Utility::year),
+        field("prevWater", &Utility::prevWater),
+        field("currWater", &Utility::currWater),
+        field("prevElectric", &Utility::prevElectric),
+        field("currElectric", &Utility::currElectric),
+        field("waterRate", &Utility::waterRate),
+        field("electricRate", &Utility::electricRate));
+};
+template<> struct Schema<Invoice> {
+    static constexpr auto fields = make_tuple(
+        field("invoiceID", &Invoice::invoiceID),
+        field("contractID", &Invoice::contractID),
+        field("roomNo", &Invoice::roomNo),
+        field("month", &Invoice::month),
+        field("year", &Invoice::year),
+        field("roomPrice", &Invoice::roomPrice),
+        field("internetFee", &Invoice::internetFee),
+        field("waterBill", &Invoice::waterBill),
+        field("electricBill", &Invoice::electricBill),
+        field("total", &Invoice::total),
+        field("status", &Invoice::status));
+};
+template<> struct Schema<Payment> {
+    static constexpr auto fields = make_tuple(
+        field("invoiceID", &Payment::invoiceID),
+        field("amount", &Payment::amount),
+        field("date", &Payment::date));
+};
+template<> struct Schema<Admin> {
+    static constexpr auto fields = make_tuple(
+        field("username", &Admin::username),
+        field("password", &Admin::password));
+};
+template<> struct Schema<ExpiredContract> {
+    static constexpr auto fields = make_tuple(
+        field("contractID", &ExpiredContract::contractID),
+        field("endDate", &ExpiredContract::endDate));
+};
+
+// Text form: one row per line, fields joined by '|'. Numbers are written the
+// same way to_string() does (%f for doubles) so existing .dat files load unchanged.
+inline bool readToken(string_view line, size_t &pos, string_view &tok){
+    if(pos > line.size()) return false; // ran out of fields
+    size_t bar = line.find('|', pos);
+    if(bar == string_view::npos) bar = line.size();
+    tok = line.substr(pos, bar - pos);
+    pos = bar + 1;
+    return true;
+}
+inline bool parseValue(string_view tok, string &out){ out.assign(tok.data(), tok.size()); return true; }
+template<class N>
+inline bool parseValue(string_view tok, N &out){
+    const char* b = tok.data();
+    const char* e = b + tok.size();
+    if(b!=e && *b=='+') ++b;
+    auto r = from_chars(b, e, out);
+    return r.ec == errc() && r.ptr == e; // "2025-06-01" or "305A" is not a number
+}
+inline void formatValue(string &buf, const string &v){ buf += v; }
+inline void formatValue(string &buf, int v){
+    char tmp[16];
+    auto r = to_chars(tmp, tmp+sizeof(tmp), v);
+    buf.append(tmp, r.ptr);
 }
-void saveRooms(const vector<Room>& v){
-    ofstream f(ROOM_FILE, ios::trunc);
-    for(auto &r: v) f << join({r.roomNo, r.type, r.status}) << "\n";
+inline void formatValue(string &buf, double v){
+    char tmp[384];
+    auto r = to_chars(tmp, tmp+sizeof(tmp), v, chars_format::fixed, 6);
+    buf.append(tmp, r.ptr);
 }
 
-vector<Tenant> loadTenants(){
-    vector<Tenant> v;
-    ifstream f(TENANT_FILE);
-    string line;
-    while(getline(f, line)){
-        if(line.empty()) continue;
-        auto p = split(line);
-        if(p.size()>=7) v.push_back(Tenant{p[0], p[1], p[2], p[3], p[4], p[5], p[6]});
-    }
-    return v;
+// Binary form: "DRMB", field count, then per row each field in order
+// (strings as uint32 length + bytes, int as int32, double as 8 raw bytes).
+inline void writeBinary(string &buf, const string &v){
+    uint32_t n = (uint32_t)v.size();
+    buf.append((const char*)&n, sizeof(n));
+    buf += v;
 }
-void saveTenants(const vector<Tenant>& v){
-    ofstream f(TENANT_FILE, ios::trunc);
-    for(auto &t: v) f << join({t.tenantID, t.name, t.phone, t.citizenID, t.birthDate, t.address, t.roomNo}) << "\n";
+template<class N>
+inline void writeBinary(string &buf, N v){ buf.append((const char*)&v, sizeof(v)); }
+inline bool readBinary(string_view data, size_t &pos, string &out){
+    uint32_t n;
+    if(data.size() - pos < sizeof(n)) return false;
+    memcpy(&n, data.data()+pos, sizeof(n)); pos += sizeof(n);
+    if(data.size() - pos < n) return false;
+    out.assign(data.data()+pos, n); pos += n;
+    return true;
+}
+template<class N>
+inline bool readBinary(string_view data, size_t &pos, N &out){
+    if(data.size() - pos < sizeof(out)) return false;
+    memcpy(&out, data.data()+pos, sizeof(out)); pos += sizeof(out);
+    return true;
 }
 
-vector<Contract> loadContracts(){
-    vector<Contract> v;
-    ifstream f(CONTRACT_FILE);
-    string line;
-    while(getline(f, line)){
-        if(line.empty()) continue;
-        auto p = split(line);
-        if(p.size()>=7) v.push_back(Contract{p[0], p[1], p[2], p[3], p[4], stod(p[5]), stod(p[6])});
+template<class T> struct Filter;
+
+template<class T>
+struct Table {
+    static constexpr size_t width = tuple_size<decltype(Schema<T>::fields)>::value;
+
+    static constexpr array<const char*, width> names =
+        apply([](const auto&... f){ return array<const char*, width>{f.name...}; }, Schema<T>::fields);
+
+    static int fieldIndex(const string &name){
+        for(size_t i=0;i<width;++i) if(name==names[i]) return (int)i;
+        return -1;
     }
-    return v;
+    // Call fn with the i-th field of row (string, int or double).
+    template<class F>
+    static void visitField(const T &row, size_t i, F &&fn){
+        size_t k = 0;
+        apply([&](const auto&... f){ ((k++==i ? void(fn(row.*(f.member))) : void()), ...); }, Schema<T>::fields);
+    }
+
+    // Split a text row into its field tokens without copying. Extra trailing
+    // fields are ignored, as before; a trailing empty field (e.g. a tenant
+    // with no room) is accepted.
+    static bool split(string_view line, array<string_view, width> &toks){
+        size_t pos = 0;
+        for(auto &t: toks) if(!readToken(line, pos, t)) return false;
+        return true;
+    }
+    static bool parseTokens(const array<string_view, width> &toks, T &out){
+        size_t i = 0;
+        bool ok = true;
+        apply([&](const auto&... f){
+            ((ok = ok && parseValue(toks[i++], out.*(f.member))), ...);
+        }, Schema<T>::fields);
+        return ok;
+    }
+    static bool parse(string_view line, T &out){
+        array<string_view, width> toks;
+        return split(line, toks) && parseTokens(toks, out);
+    }
+    static void format(const T &row, string &buf){
+        bool first = true;
+        apply([&](const auto&... f){
+            ((first ? void(first = false) : void(buf += '|'), formatValue(buf, row.*(f.member))), ...);
+        }, Schema<T>::fields);
+    }
+
+    // Rows rejected by where are skipped on their raw tokens, before any
+    // field is converted or copied.
+    static vector<T> load(const string &file, const Filter<T> &where){
+        vector<T> v;
+        ifstream f(file);
+        string line;
+        array<string_view, width> toks;
+        T row{};
+        while(getline(f, line)){
+            if(line.empty() || !split(line, toks)) continue;
+            if(!where.test(toks)) continue;
+            if(parseTokens(toks, row)) v.push_back(row);
+        }
+        return v;
+    }
+    // Returns false if anything failed to reach the file.
+    static bool save(const string &file, const vector<T> &v){
+        ofstream f(file, ios::trunc);
+        string buf;
+        buf.reserve(1 << 16);
+        for(auto &row: v){
+            format(row, buf);
+            buf += '\n';
+            if(buf.size() >= (1 << 16)){ f.write(buf.data(), buf.size()); buf.clear(); }
+        }
+        f.write(buf.data(), buf.size());
+        f.close();
+        return !f.fail();
+    }
+
+    // Returns false and sets err if file is missing, not in this format, was
+    // written for a different field list, or ends in the middle of a row.
+    static bool loadBinary(const string &file, vector<T> &out, string &err){
+        ifstream f(file, ios::binary | ios::ate);
+        if(!f){ err = "cannot open"; return false; }
+        string data((size_t)f.tellg(), '\0');
+        f.seekg(0);
+        if(!f.read(data.data(), data.size())){ err = "read failed"; return false; }
+        uint32_t n = 0;
+        if(data.size() < 8 || data.compare(0, 4, "DRMB") != 0){ err = "not a binary table"; return false; }
+        memcpy(&n, data.data()+4, sizeof(n));
+        if(n != width){ err = "has " + to_string(n) + " fields, expected " + to_string(width); return false; }
+        vector<T> v;
+        string_view sv(data);
+        size_t pos = 8;
+        T row{};
+        while(pos < sv.size()){
+            bool ok = true;
+            apply([&](const auto&... f){
+                ((ok = ok && readBinary(sv, pos, row.*(f.member))), ...);
+            }, Schema<T>::fields);
+            if(!ok){ err = "truncated after row " + to_string(v.size()); return false; }
+            v.push_back(row);
+        }
+        out = move(v);
+        return true;
+    }
+    static bool saveBinary(const string &file, const vector<T> &v){
+        string buf = "DRMB";
+        writeBinary(buf, (uint32_t)width);
+        for(auto &row: v){
+            apply([&](const auto&... f){ (writeBinary(buf, row.*(f.member)), ...); }, Schema<T>::fields);
+        }
+        ofstream f(file, ios::binary | ios::trunc);
+        f.write(buf.data(), buf.size());
+        f.close();
+        return !f.fail();
+    }
+};
+
+// "YYYY-MM-DD" -> days since 1970-01-01, or -1 if malformed
+int parseDate(const string &d){
+    int y, m, day;
+    if(d.size()!=10 || d[4]!='-' || d[7]!='-') return -1;
+    if(!parseValue(string_view(d).substr(0,4), y) || !parseValue(string_view(d).substr(5,2), m) || !parseValue(string_view(d).substr(8,2), day)) return -1;
+    static const int monthDays[12] = {31,28,31,30,31,30,31,31,30,31,30,31};
+    bool leap = (y%4==0 && y%100!=0) || y%400==0;
+    if(m<1 || m>12 || day<1 || day>monthDays[m-1] + (m==2 && leap)) return -1;
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y-399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+    return era * 146097 + doe - 719468;
 }
-void saveContracts(const vector<Contract>& v){
-    ofstream f(CONTRACT_FILE, ios::trunc);
-    for(auto &c: v) f << join({c.contractID, c.tenantID, c.roomNo, c.startDate, c.endDate, to_string(c.roomPrice), to_string(c.internetFee)}) << "\n";
+
+// ---------- Filters ----------
+// Small predicate language for list/search views:
+//     field op value [AND|OR field op value ...]
+// ops: = != < <= > >= ~ (contains). AND binds tighter than OR. Values may be
+// quoted ("John Doe"). Numbers compare numerically ("month = 3" matches 03).
+struct Cond {
+    size_t field;
+    string op;
+    string value;
+    double num;
+    bool isNum;
+};
+
+inline bool parseNumber(string_view tok, double &out){
+    return !tok.empty() && parseValue(tok, out);
+}
+inline bool testCompare(int cmp, const string &op){
+    if(op=="=") return cmp==0;
+    if(op=="!=") return cmp!=0;
+    if(op=="<") return cmp<0;
+    if(op=="<=") return cmp<=0;
+    if(op==">") return cmp>0;
+    return cmp>=0; // ">="
+}
+inline bool testToken(string_view tok, const Cond &c){
+    if(c.op=="~") return tok.find(c.value) != string_view::npos;
+    double n;
+    if(c.isNum && parseNumber(tok, n)) return testCompare(n<c.num ? -1 : (n>c.num ? 1 : 0), c.op);
+    return testCompare(tok.compare(c.value), c.op);
+}
+inline bool testValue(const string &v, const Cond &c){ return testToken(v, c); }
+// Typed fields behave as their on-disk text would: "~" and non-numeric
+// values match against the formatted number, the rest compare numerically.
+template<class N>
+inline bool testValue(N v, const Cond &c){
+    if(c.op=="~" || !c.isNum){
+        string buf;
+        formatValue(buf, v);
+        return testToken(buf, c);
+    }
+    return testCompare(v<c.num ? -1 : (v>c.num ? 1 : 0), c.op);
 }
 
-vector<Utility> loadUtilities(){
-    vector<Utility> v;
-    ifstream f(UTILITY_FILE);
-    string line;
-    while(getline(f, line)){
-        if(line.empty()) continue;
-        auto p = split(line);
-        if(p.size()>=9){
-            v.push_back(Utility{p[0], p[1], p[2], stoi(p[3]), stoi(p[4]), stoi(p[5]), stoi(p[6]), stod(p[7]), stod(p[8])});
+template<class T>
+struct Filter {
+    vector<vector<Cond>> anyOf; // OR of AND-groups; empty = everything
+
+    bool empty() const { return anyOf.empty(); }
+
+    bool test(const array<string_view, Table<T>::width> &toks) const {
+        if(anyOf.empty()) return true;
+        for(auto &group: anyOf){
+            bool all = true;
+            for(auto &c: group) if(!testToken(toks[c.field], c)){ all = false; break; }
+            if(all) return true;
+        }
+        return false;
+    }
+    bool test(const T &row) const {
+        if(anyOf.empty()) return true;
+        for(auto &group: anyOf){
+            bool all = true;
+            for(auto &c: group){
+                bool ok = false;
+                Table<T>::visitField(row, c.field, [&](const auto &v){
+                    ok = testValue(v, c);
+                });
+                if(!ok){ all = false; break; }
+            }
+            if(all) return true;
         }
+        return false;
+    }
+
+    // Returns false and sets err if expr is malformed.
+    static bool compile(const string &expr, Filter &out, string &err){
+        vector<string> toks;
+        size_t i = 0;
+        while(i < expr.size()){
+            char ch = expr[i];
+            if(isspace((unsigned char)ch)){ ++i; continue; }
+            if(ch=='"'){
+                size_t e = expr.find('"', i+1);
+                if(e==string::npos){ err = "unterminated quote"; return false; }
+                toks.push_back("\"" + expr.substr(i+1, e-i-1));
+                i = e+1;
+            } else if(strchr("=!<>~", ch)){
+                size_t e = i+1;
+                if(e < expr.size() && expr[e]=='=' && ch!='=' && ch!='~') ++e;
+                toks.push_back(expr.substr(i, e-i));
+                i = e;
+            } else {
+                size_t e = i;
+                while(e < expr.size() && !isspace((unsigned char)expr[e]) && !strchr("=!<>~\"", expr[e])) ++e;
+                toks.push_back(expr.substr(i, e-i));
+                i = e;
+            }
+        }
+        out.anyOf.clear();
+        out.anyOf.emplace_back();
+        for(size_t k = 0; k < toks.size();){
+            if(k+3 > toks.size()){ err = "expected: field op value"; return false; }
+            int fi = Table<T>::fieldIndex(toks[k]);
+            if(fi < 0){ err = "unknown field '" + toks[k] + "'"; return false; }
+            const string &op = toks[k+1];
+            if(op!="=" && op!="!=" && op!="<" && op!="<=" && op!=">" && op!=">=" && op!="~"){ err = "unknown operator '" + op + "'"; return false; }
+            Cond c{(size_t)fi, op, toks[k+2], 0, false};
+            if(!c.value.empty() && c.value[0]=='"') c.value.erase(0, 1);
+            else c.isNum = parseNumber(c.value, c.num);
+            out.anyOf.back().push_back(c);
+            k += 3;
+            if(k == toks.size()) break;
+            string conj = toks[k];
+            transform(conj.begin(), conj.end(), conj.begin(), ::toupper);
+            if(conj=="OR") out.anyOf.emplace_back();
+            else if(conj!="AND"){ err = "expected AND/OR, got '" + toks[k] + "'"; return false; }
+            if(++k == toks.size()){ err = "dangling " + conj; return false; }
+        }
+        if(out.anyOf.size()==1 && out.anyOf[0].empty()) out.anyOf.clear();
+        return true;
+    }
+};
+
+// Prompt for an optional filter; keeps asking until it parses. Empty = all rows.
+template<class T>
+Filter<T> askFilter(){
+    cin.ignore(numeric_limits<streamsize>::max(), '\n'); // rest of the menu choice line
+    while(true){
+        cout << "Filter (e.g. status = UNPAID AND year = 2025, empty for all): ";
+        string expr;
+        if(!getline(cin, expr)) return Filter<T>();
+        Filter<T> f; string err;
+        if(Filter<T>::compile(expr, f, err)) return f;
+        cout << "Bad filter: " << err << "\n";
+        cout << "Fields:";
+        for(auto n: Table<T>::names) cout << " " << n;
+        cout << "\n";
     }
-    return v;
 }
-void saveUtilities(const vector<Utility>& v){
-    ofstream f(UTILITY_FILE, ios::trunc);
-    for(auto &u: v) f << join({u.roomNo, u.month, u.year,
-                               to_string(u.prevWater), to_string(u.currWater),
-                               to_string(u.prevElectric), to_string(u.currElectric),
-                               to_string(u.waterRate), to_string(u.electricRate)}) << "\n";
+
+// ---------- Background Persistence ----------
+// Table saves are handed to a single writer thread as snapshots so leaving a
+// menu never waits on disk. Pending saves are keyed by file: a newer snapshot
+// of the same table replaces one that has not been written yet. Loads wait
+// only for their own file (read-your-writes); flush() is the exit barrier.
+// A WriteFn returns false if its output is incomplete; the target then keeps
+// its previous contents.
+class Persister {
+public:
+    using WriteFn = function<bool(const string&)>;
+
+    static Persister& instance(){
+        static Persister p;
+        return p;
+    }
+    void submit(const string &file, WriteFn fn){
+        {
+            lock_guard<mutex> lk(m);
+            pending[file] = move(fn);
+        }
+        wake.notify_one();
+    }
+    // Whether a write of file is queued or running.
+    bool busy(const string &file){
+        lock_guard<mutex> lk(m);
+        return pending.count(file) || inFlight.count(file);
+    }
+    // Returns whether the last write of file succeeded.
+    bool waitFor(const string &file){
+        unique_lock<mutex> lk(m);
+        idle.wait(lk, [&]{ return !pending.count(file) && !inFlight.count(file); });
+        return !failed.count(file);
+    }
+    void flush(){
+        unique_lock<mutex> lk(m);
+        idle.wait(lk, [&]{ return pending.empty() && inFlight.empty(); });
+    }
+    ~Persister(){
+        {
+            lock_guard<mutex> lk(m);
+            stopping = true;
+        }
+        wake.notify_one();
+        if(worker.joinable()) worker.join();
+    }
+
+private:
+    Persister() : worker([this]{ run(); }) {}
+
+    void run(){
+        unique_lock<mutex> lk(m);
+        while(true){
+            wake.wait(lk, [&]{ return stopping || !pending.empty(); });
+            if(pending.empty()) break; // stopping and drained
+            auto it = pending.begin();
+            string file = it->first;
+            WriteFn fn = move(it->second);
+            pending.erase(it);
+            inFlight.insert(file);
+            lk.unlock();
+            bool ok = writeAtomically(file, fn);
+            lk.lock();
+            if(ok) failed.erase(file); else failed.insert(file);
+            inFlight.erase(file);
+            idle.notify_all();
+        }
+    }
+    static bool writeAtomically(const string &file, const WriteFn &fn){
+        // write next to the target and swap in only once the copy is complete,
+        // so a crash or a full disk never leaves a half-written table
+        string tmp = file + ".tmp";
+        error_code ec;
+        if(fn(tmp)) filesystem::rename(tmp, file, ec); // replaces file, also on Windows
+        else ec = make_error_code(errc::io_error);
+        if(!ec) return true;
+        filesystem::remove(tmp, ec);
+        cerr << "Could not write " << file << "; previous version kept\n";
+        return false;
+    }
+
+    mutex m;
+    condition_variable wake, idle;
+    map<string, WriteFn> pending;
+    set<string> inFlight;
+    set<string> failed;
+    bool stopping = false;
+    thread worker;
+};
+
+// ---------- Versioned Tables ----------
+// The current contents of each table file live in memory as an immutable
+// snapshot. Readers pin() the snapshot they start with and keep a consistent
+// view for as long as they hold it, however many edits land meanwhile;
+// writers build a new vector and publish() it by swapping the shared_ptr
+// (atomic_load/atomic_store, which libstdc++ guards with a small internal
+// mutex pool - short, but not lock-free). A version is freed when its last
+// reader lets go of it.
+//
+// The snapshot remembers the mtime and size of the file it was read from or
+// last written as. If the file changes behind our back (another instance, a
+// hand edit, --import-binary) it is read again on the next pinTable().
+struct FileStamp {
+    bool exists = false;
+    filesystem::file_time_type mtime{};
+    uintmax_t size = 0;
+    bool operator==(const FileStamp &o) const { return exists==o.exists && mtime==o.mtime && size==o.size; }
+};
+FileStamp fileStamp(const string &file){
+    FileStamp s;
+    error_code ec;
+    s.mtime = filesystem::last_write_time(file, ec);
+    if(ec) return FileStamp{};
+    s.size = filesystem::file_size(file, ec);
+    s.exists = !ec;
+    return s;
 }
 
-vector<Invoice> loadInvoices(){
-    vector<Invoice> v;
-    ifstream f(INVOICE_FILE);
-    string line;
-    while(getline(f, line)){
-        if(line.empty()) continue;
-        auto p = split(line);
-        if(p.size()>=11){
-            v.push_back(Invoice{p[0], p[1], p[2], p[3], p[4], stod(p[5]), stod(p[6]), stod(p[7]), stod(p[8]), stod(p[9]), p[10]});
+template<class T>
+class VersionedTable {
+public:
+    using Snapshot = shared_ptr<const vector<T>>;
+
+    explicit VersionedTable(const string &file) : disk(fileStamp(file)), current(make_shared<const vector<T>>(Table<T>::load(file, {}))) {}
+    Snapshot pin() const { return atomic_load(&current); }
+    void publish(Snapshot next){
+        atomic_store(&current, move(next));
+        ++ver;
+    }
+    uint64_t version() const { return ver.load(); }
+
+    // Our own write of the file finished; its stamp is not an outside change.
+    void wrote(const FileStamp &s){
+        lock_guard<mutex> lk(m);
+        disk = s;
+    }
+    // Re-read file if it no longer matches what we last read or wrote. A
+    // publish() that lands meanwhile is newer and wins.
+    void refresh(const string &file){
+        uint64_t seen = ver.load();
+        FileStamp now = fileStamp(file);
+        {
+            lock_guard<mutex> lk(m);
+            if(now == disk) return;
         }
+        auto fresh = make_shared<const vector<T>>(Table<T>::load(file, {}));
+        lock_guard<mutex> lk(m);
+        if(ver.load() != seen) return;
+        disk = now;
+        publish(move(fresh));
     }
-    return v;
+
+private:
+    mutex m;
+    FileStamp disk;
+    Snapshot current;
+    atomic<uint64_t> ver{1};
+};
+
+// Table for a file, read from disk the first time it is used.
+template<class T>
+VersionedTable<T>& versioned(const string &file){
+    struct Slot {
+        once_flag once;
+        unique_ptr<VersionedTable<T>> table;
+    };
+    static mutex m;
+    static map<string, shared_ptr<Slot>> tables;
+    shared_ptr<Slot> slot;
+    {
+        lock_guard<mutex> lk(m);
+        auto &sp = tables[file];
+        if(!sp) sp = make_shared<Slot>();
+        slot = sp;
+    }
+    call_once(slot->once, [&]{
+        Persister::instance().waitFor(file);
+        slot->table = make_unique<VersionedTable<T>>(file);
+    });
+    return *slot->table;
+}
+
+// Current snapshot of file, re-read first if it was changed outside this
+// process. While one of our own writes is queued the snapshot is newer than
+// the file, so the check is skipped.
+template<class T>
+typename VersionedTable<T>::Snapshot pinTable(const string &file){
+    auto &t = versioned<T>(file);
+    if(!Persister::instance().busy(file)) t.refresh(file);
+    return t.pin();
+}
+
+// Unfiltered loads copy the pinned snapshot for the caller to edit; filtered
+// loads push the predicate into the file scan.
+template<class T>
+vector<T> loadTable(const string &file, const Filter<T> &where){
+    if(where.empty()) return *pinTable<T>(file);
+    Persister::instance().waitFor(file);
+    return Table<T>::load(file, where);
 }
-void saveInvoices(const vector<Invoice>& v){
-    ofstream f(INVOICE_FILE, ios::trunc);
-    for(auto &inv: v){
-        f << join({inv.invoiceID, inv.contractID, inv.roomNo, inv.month, inv.year,
-                   to_string(inv.roomPrice), to_string(inv.internetFee),
-                   to_string(inv.waterBill), to_string(inv.electricBill),
-                   to_string(inv.total), inv.status}) << "\n";
+template<class T>
+void saveTable(const string &file, const vector<T> &v){
+    auto snap = make_shared<const vector<T>>(v);
+    auto &table = versioned<T>(file);
+    table.publish(snap);
+    Persister::instance().submit(file, [snap, &table](const string &path){
+        if(!Table<T>::save(path, *snap)) return false;
+        table.wrote(fileStamp(path)); // the rename keeps mtime and size
+        return true;
+    });
+}
+
+// ---------- Thread Pool ----------
+// Fixed set of workers used to fan work out across buildings.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned n){
+        if(n == 0) n = 1;
+        for(unsigned i=0;i<n;++i) workers.emplace_back([this]{ run(); });
+    }
+    ~ThreadPool(){
+        {
+            lock_guard<mutex> lk(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(auto &t: workers) t.join();
+    }
+    template<class F>
+    auto submit(F fn) -> future<decltype(fn())> {
+        auto task = make_shared<packaged_task<decltype(fn())()>>(move(fn));
+        auto fut = task->get_future();
+        {
+            lock_guard<mutex> lk(m);
+            jobs.push_back([task]{ (*task)(); });
+        }
+        wake.notify_one();
+        return fut;
+    }
+    static ThreadPool& shared(){
+        static ThreadPool p(thread::hardware_concurrency());
+        return p;
     }
+
+private:
+    void run(){
+        while(true){
+            function<void()> job;
+            {
+                unique_lock<mutex> lk(m);
+                wake.wait(lk, [&]{ return stopping || !jobs.empty(); });
+                if(jobs.empty()) return;
+                job = move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    mutex m;
+    condition_variable wake;
+    deque<function<void()>> jobs;
+    bool stopping = false;
+    vector<thread> workers;
+};
+
+// Run fn(building) for every building on the pool; results keep building order.
+template<class F>
+auto forEachBuilding(const vector<string> &buildings, F fn) -> vector<decltype(fn(string()))> {
+    vector<future<decltype(fn(string()))>> futs;
+    for(auto &b: buildings) futs.push_back(ThreadPool::shared().submit([fn, b]{ return fn(b); }));
+    vector<decltype(fn(string()))> out;
+    for(auto &f: futs) out.push_back(f.get());
+    return out;
 }
 
-vector<Payment> loadPayments(){
-    vector<Payment> v;
-    ifstream f(PAYMENT_FILE);
+// ---------- Load / Save ----------
+vector<Room> loadRooms(const Filter<Room> &where = {}){ return loadTable<Room>(dataPath(ROOM_FILE), where); }
+void saveRooms(const vector<Room>& v){ saveTable(dataPath(ROOM_FILE), v); }
+
+vector<Tenant> loadTenants(const Filter<Tenant> &where = {}){ return loadTable<Tenant>(dataPath(TENANT_FILE), where); }
+void saveTenants(const vector<Tenant>& v){ saveTable(dataPath(TENANT_FILE), v); }
+
+vector<Contract> loadContracts(const Filter<Contract> &where = {}){ return loadTable<Contract>(dataPath(CONTRACT_FILE), where); }
+void saveContracts(const vector<Contract>& v){ saveTable(dataPath(CONTRACT_FILE), v); }
+
+vector<Utility> loadUtilities(const Filter<Utility> &where = {}){ return loadTable<Utility>(dataPath(UTILITY_FILE), where); }
+void saveUtilities(const vector<Utility>& v){ saveTable(dataPath(UTILITY_FILE), v); }
+
+vector<Invoice> loadInvoices(const Filter<Invoice> &where = {}){ return loadTable<Invoice>(dataPath(INVOICE_FILE), where); }
+void saveInvoices(const vector<Invoice>& v){ saveTable(dataPath(INVOICE_FILE), v); }
+
+vector<Payment> loadPayments(const Filter<Payment> &where = {}){ return loadTable<Payment>(dataPath(PAYMENT_FILE), where); }
+void savePayments(const vector<Payment>& v){ saveTable(dataPath(PAYMENT_FILE), v); }
+
+vector<ExpiredContract> loadExpired(){ return loadTable<ExpiredContract>(dataPath(EXPIRED_FILE), {}); }
+void saveExpired(const vector<ExpiredContract>& v){ saveTable(dataPath(EXPIRED_FILE), v); }
+
+vector<Admin> loadAdmins(const Filter<Admin> &where = {}){ return loadTable<Admin>(ADMIN_FILE, where); }
+void saveAdmins(const vector<Admin>& v){ saveTable(ADMIN_FILE, v); }
+
+// ---------- Cursors ----------
+// A cursor walks one table a page at a time, from an in-memory vector or
+// straight from the .dat file. It remembers where each visited page starts
+// (a vector index or a file offset), so prev/jump never re-read from the top
+// and only one page of rows is built at a time.
+template<class T>
+struct VectorSource {
+    using Pos = size_t;
+    const vector<T> *rows;
+
+    Pos begin() const { return 0; }
+    bool next(Pos &p, T &out, const Filter<T> &where){
+        while(p < rows->size()){
+            const T &r = (*rows)[p++];
+            if(where.test(r)){ out = r; return true; }
+        }
+        return false;
+    }
+};
+
+template<class T>
+struct FileSource {
+    using Pos = streamoff;
+    shared_ptr<ifstream> f;
     string line;
-    while(getline(f, line)){
-        if(line.empty()) continue;
-        auto p = split(line);
-        if(p.size()>=3) v.push_back(Payment{p[0], stod(p[1]), p[2]});
+    array<string_view, Table<T>::width> toks;
+
+    Pos begin() const { return 0; }
+    bool next(Pos &p, T &out, const Filter<T> &where){
+        f->clear();
+        f->seekg(p);
+        while(getline(*f, line)){
+            p += line.size() + 1;
+            if(!line.empty() && line.back()=='\r') line.pop_back();
+            if(line.empty() || !Table<T>::split(line, toks) || !where.test(toks)) continue;
+            if(Table<T>::parseTokens(toks, out)) return true;
+        }
+        return false;
     }
-    return v;
+};
+
+template<class T, class Source>
+class Cursor {
+public:
+    Cursor(Source src, Filter<T> where, size_t pageSize = 20)
+        : src(move(src)), where(move(where)), size(max<size_t>(pageSize, 1)) { reset(); }
+
+    void setPageSize(size_t n){ size = max<size_t>(n, 1); reset(); }
+    size_t pageSize() const { return size; }
+    size_t page() const { return cur; }
+    bool isLast() const { return last; }
+    const vector<T>& rows() const { return buf; }
+
+    // Load page n (0-based). Returns false, keeping the current page, if n is past the end.
+    bool jump(size_t n){
+        size_t k = min(n, starts.size()-1);
+        while(true){
+            typename Source::Pos p = starts[k];
+            vector<T> rows;
+            T row{};
+            while(rows.size() < size && src.next(p, row, where)) rows.push_back(row);
+            if(rows.empty() && k > 0) return false;
+            bool more = false;
+            if(rows.size() == size){ // peek one row ahead to know if a next page exists
+                typename Source::Pos q = p;
+                more = src.next(q, row, where);
+            }
+            if(more && k+1 == starts.size()) starts.push_back(p);
+            if(k == n || !more){
+                if(k != n) return false;
+                buf = move(rows); cur = k; last = !more;
+                return true;
+            }
+            ++k;
+        }
+    }
+    bool next(){ return !last && jump(cur+1); }
+    bool prev(){ return cur > 0 && jump(cur-1); }
+
+private:
+    void reset(){ starts.assign(1, src.begin()); cur = 0; last = true; buf.clear(); }
+
+    Source src;
+    Filter<T> where;
+    size_t size;
+    vector<typename Source::Pos> starts;
+    size_t cur = 0;
+    bool last = true;
+    vector<T> buf;
+};
+
+template<class T>
+Cursor<T, VectorSource<T>> vectorCursor(const vector<T> &rows, Filter<T> where = {}){
+    return Cursor<T, VectorSource<T>>(VectorSource<T>{&rows}, move(where));
 }
-void savePayments(const vector<Payment>& v){
-    ofstream f(PAYMENT_FILE, ios::trunc);
-    for(auto &p: v) f << join({p.invoiceID, to_string(p.amount), p.date}) << "\n";
+template<class T>
+Cursor<T, FileSource<T>> fileCursor(const string &file, Filter<T> where = {}){
+    Persister::instance().waitFor(file);
+    auto f = make_shared<ifstream>(file, ios::binary);
+    return Cursor<T, FileSource<T>>(FileSource<T>{f, {}, {}}, move(where));
 }
 
-vector<Admin> loadAdmins(){
-    vector<Admin> v;
-    ifstream f(ADMIN_FILE);
-    string line;
-    while(getline(f,line)){
-        if(line.empty()) continue;
-        auto p = split(line);
-        if(p.size()>=2) v.push_back(Admin{p[0], p[1]});
+// Interactive pager: n/Enter next, p prev, j N jump, s N page size, q quit.
+// Expects the rest of the menu line to be consumed already (askFilter does).
+template<class T, class Source, class Header, class Row>
+void browse(Cursor<T, Source> &cur, Header header, Row row){
+    bool ok = cur.jump(0);
+    while(true){
+        header();
+        if(ok) for(auto &r: cur.rows()) row(r);
+        cout << "-- page " << cur.page()+1 << (cur.isLast() ? " (last)" : "") << ", " << cur.rows().size() << " rows --\n";
+        cout << "[n]ext [p]rev [j N] jump [s N] page size [q]uit: ";
+        string cmd;
+        if(!getline(cin, cmd)) return;
+        stringstream ss(cmd);
+        string op; size_t n = 0;
+        ss >> op >> n;
+        if(op=="q") return;
+        if(op=="p"){ if(!cur.prev()) cout << "Already at first page.\n"; }
+        else if(op=="j" && n > 0){ if(!cur.jump(n-1)) cout << "No page " << n << ".\n"; }
+        else if(op=="s" && n > 0){ cur.setPageSize(n); ok = cur.jump(0); }
+        else if(op=="" || op=="n"){ if(!cur.next()){ cout << "End of list.\n"; return; } }
+        else cout << "Invalid.\n";
+    }
+}
+
+// ---------- Occupancy Timeline ----------
+// Per-room interval tree over contract [startDate, endDate] (inclusive, in
+// days). AVL-balanced on (start, contractID), each node caching the largest
+// end in its subtree, so point and range overlap queries are O(log n + k).
+class IntervalTree {
+public:
+    struct Interval { int lo, hi; string id; };
+
+    void insert(const Interval &iv){ root = insert(move(root), iv); ++count; }
+    bool erase(int lo, const string &id){
+        bool found = false;
+        root = erase(move(root), lo, id, found);
+        if(found) --count;
+        return found;
+    }
+    // All intervals intersecting [lo, hi].
+    void overlapping(int lo, int hi, vector<const Interval*> &out) const { collect(root.get(), lo, hi, out); }
+    size_t size() const { return count; }
+
+private:
+    struct Node {
+        Interval iv;
+        int maxHi, height;
+        unique_ptr<Node> l, r;
+    };
+    static int h(const unique_ptr<Node> &n){ return n ? n->height : 0; }
+    static void update(Node *n){
+        n->height = 1 + max(h(n->l), h(n->r));
+        n->maxHi = n->iv.hi;
+        if(n->l) n->maxHi = max(n->maxHi, n->l->maxHi);
+        if(n->r) n->maxHi = max(n->maxHi, n->r->maxHi);
     }
-    return v;
+    static unique_ptr<Node> rotateRight(unique_ptr<Node> n){
+        auto l = move(n->l);
+        n->l = move(l->r);
+        update(n.get());
+        l->r = move(n);
+        update(l.get());
+        return l;
+    }
+    static unique_ptr<Node> rotateLeft(unique_ptr<Node> n){
+        auto r = move(n->r);
+        n->r = move(r->l);
+        update(n.get());
+        r->l = move(n);
+        update(r.get());
+        return r;
+    }
+    static unique_ptr<Node> balance(unique_ptr<Node> n){
+        update(n.get());
+        int bf = h(n->l) - h(n->r);
+        if(bf > 1){
+            if(h(n->l->l) < h(n->l->r)) n->l = rotateLeft(move(n->l));
+            return rotateRight(move(n));
+        }
+        if(bf < -1){
+            if(h(n->r->r) < h(n->r->l)) n->r = rotateRight(move(n->r));
+            return rotateLeft(move(n));
+        }
+        return n;
+    }
+    static bool less(int lo, const string &id, const Interval &b){ return lo < b.lo || (lo == b.lo && id < b.id); }
+
+    static unique_ptr<Node> insert(unique_ptr<Node> n, const Interval &iv){
+        if(!n){
+            auto leaf = make_unique<Node>();
+            leaf->iv = iv;
+            update(leaf.get());
+            return leaf;
+        }
+        if(less(iv.lo, iv.id, n->iv)) n->l = insert(move(n->l), iv);
+        else n->r = insert(move(n->r), iv);
+        return balance(move(n));
+    }
+    static unique_ptr<Node> takeMin(unique_ptr<Node> &n){
+        if(!n->l){
+            auto m = move(n);
+            n = move(m->r);
+            return m;
+        }
+        auto m = takeMin(n->l);
+        n = balance(move(n));
+        return m;
+    }
+    static unique_ptr<Node> erase(unique_ptr<Node> n, int lo, const string &id, bool &found){
+        if(!n) return n;
+        if(n->iv.lo == lo && n->iv.id == id){
+            found = true;
+            if(!n->l) return move(n->r);
+            if(!n->r) return move(n->l);
+            auto m = takeMin(n->r);
+            m->l = move(n->l);
+            m->r = move(n->r);
+            return balance(move(m));
+        }
+        if(less(lo, id, n->iv)) n->l = erase(move(n->l), lo, id, found);
+        else n->r = erase(move(n->r), lo, id, found);
+        return balance(move(n));
+    }
+    static void collect(const Node *n, int lo, int hi, vector<const Interval*> &out){
+        if(!n || n->maxHi < lo) return;
+        collect(n->l.get(), lo, hi, out);
+        if(n->iv.lo > hi) return; // everything to the right starts later still
+        if(n->iv.hi >= lo) out.push_back(&n->iv);
+        collect(n->r.get(), lo, hi, out);
+    }
+
+    unique_ptr<Node> root;
+    size_t count = 0;
+};
+
+// roomNo -> timeline of its contracts
+using Occupancy = map<string, IntervalTree>;
+
+Occupancy buildOccupancy(const vector<Contract> &contracts){
+    Occupancy occ;
+    for(auto &c: contracts){
+        int lo = parseDate(c.startDate), hi = parseDate(c.endDate);
+        if(lo >= 0 && hi >= lo) occ[c.roomNo].insert({lo, hi, c.contractID});
+    }
+    return occ;
 }
-void saveAdmins(const vector<Admin>& v){
-    ofstream f(ADMIN_FILE, ios::trunc);
-    for(auto &a: v) f << join({a.username, a.password}) << "\n";
+// First contract (other than ignoreID) in roomNo overlapping [lo, hi], or "".
+string findOverlap(const Occupancy &occ, const string &roomNo, int lo, int hi, const string &ignoreID = ""){
+    auto it = occ.find(roomNo);
+    if(it == occ.end()) return "";
+    vector<const IntervalTree::Interval*> hits;
+    it->second.overlapping(lo, hi, hits);
+    for(auto iv: hits) if(iv->id != ignoreID) return iv->id;
+    return "";
 }
 
 // ---------- Finders ----------
@@ -264,13 +1175,157 @@ Invoice* findInvoice(vector<Invoice>& invs, const string &invoiceID){
     return nullptr;
 }
 
+// ---------- Contract Expiry ----------
+// Contracts wait in a min-heap on end date. check() only pops the ones that
+// have come within EXPIRY_NOTICE_DAYS of their end (upcoming move-outs) and,
+// once the end date has passed, expires them so their room can be released.
+// Edits push a fresh heap entry; outdated entries are dropped when popped.
+const int EXPIRY_NOTICE_DAYS = 30;
+
+int todayDays(){
+    time_t now = time(nullptr);
+    char buf[16];
+    strftime(buf, sizeof(buf), "%Y-%m-%d", localtime(&now));
+    return parseDate(buf);
+}
+
+class ExpiryScheduler {
+public:
+    struct Info {
+        string contractID, tenantID, roomNo, endDate;
+        int start, end;
+    };
+    struct Notice {
+        vector<Info> upcoming; // newly within the notice window
+        vector<Info> expired;  // newly past their end date
+    };
+
+    bool loadedFor(const string &building) const { return ready && loadedBuilding == building; }
+    // Ends already in handled were dealt with in an earlier run and are not
+    // reported or released again; a changed end date is tracked afresh.
+    void load(const string &building, const vector<Contract> &contracts, const vector<ExpiredContract> &handled){
+        heap = {};
+        active.clear();
+        due.clear();
+        byRoom.clear();
+        set<pair<string, string>> done;
+        for(auto &h: handled) done.insert({h.contractID, h.endDate});
+        for(auto &c: contracts) if(!done.count({c.contractID, c.endDate})) track(c);
+        loadedBuilding = building;
+        ready = true;
+    }
+    // Add a contract, or re-schedule it after its dates changed.
+    void track(const Contract &c){
+        untrack(c.contractID);
+        Info info{c.contractID, c.tenantID, c.roomNo, c.endDate, parseDate(c.startDate), parseDate(c.endDate)};
+        if(info.start < 0 || info.end < 0) return;
+        active[c.contractID] = info;
+        byRoom[c.roomNo].insert(c.contractID);
+        heap.push({info.end, c.contractID});
+    }
+    void untrack(const string &contractID){
+        auto it = active.find(contractID);
+        if(it == active.end()) return;
+        due.erase({it->second.end, contractID});
+        byRoom[it->second.roomNo].erase(contractID);
+        active.erase(it); // its heap entry goes stale
+    }
+    Notice check(int today){
+        Notice n;
+        while(!heap.empty() && heap.top().first <= today + EXPIRY_NOTICE_DAYS){
+            Entry e = heap.top();
+            heap.pop();
+            auto it = active.find(e.second);
+            if(it == active.end() || it->second.end != e.first) continue; // stale
+            if(due.insert(e).second && e.first >= today) n.upcoming.push_back(it->second);
+        }
+        while(!due.empty() && due.begin()->first < today){
+            Entry e = *due.begin();
+            Info info = active[e.second];
+            untrack(e.second);
+            n.expired.push_back(info);
+        }
+        return n;
+    }
+    // Contracts ending within the notice window, soonest first.
+    vector<Info> upcoming() const {
+        vector<Info> out;
+        for(auto &e: due) out.push_back(active.at(e.second));
+        return out;
+    }
+    bool isExpired(const Contract &c, int today) const {
+        int end = parseDate(c.endDate);
+        return end >= 0 && end < today;
+    }
+    // Whether another still-running contract holds roomNo today.
+    bool roomInUse(const string &roomNo, int today) const {
+        auto it = byRoom.find(roomNo);
+        if(it == byRoom.end()) return false;
+        for(auto &id: it->second){
+            const Info &info = active.at(id);
+            if(info.start <= today && info.end >= today) return true;
+        }
+        return false;
+    }
+
+private:
+    using Entry = pair<int, string>; // end day, contractID
+    priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+    map<string, Info> active;
+    set<Entry> due;
+    map<string, set<string>> byRoom;
+    string loadedBuilding;
+    bool ready = false;
+};
+
+ExpiryScheduler& expiry(){
+    static ExpiryScheduler s;
+    return s;
+}
+
+// Runs at startup and whenever a menu returns: flags contracts nearing their
+// end and releases the rooms of ones that have ended.
+void CheckExpiries(){
+    ExpiryScheduler &ex = expiry();
+    bool fresh = !ex.loadedFor(currentBuilding);
+    if(fresh) ex.load(currentBuilding, loadContracts(), loadExpired());
+    int today = todayDays();
+    auto n = ex.check(today);
+
+    if(!n.expired.empty()){
+        vector<Room> rooms = loadRooms();
+        vector<Tenant> tenants = loadTenants();
+        vector<ExpiredContract> handled = loadExpired();
+        for(auto &info: n.expired){
+            handled.push_back(ExpiredContract{info.contractID, info.endDate});
+            cout << "Contract " << info.contractID << " (room " << info.roomNo << ") ended on " << info.endDate;
+            if(!ex.roomInUse(info.roomNo, today)){
+                Room* pr = findRoom(rooms, info.roomNo);
+                if(pr && pr->status == "Occupied") pr->status = "Available";
+                Tenant* pt = findTenant(tenants, info.tenantID);
+                if(pt && pt->roomNo == info.roomNo) pt->roomNo = "";
+                cout << " - room released";
+            }
+            cout << ".\n";
+        }
+        saveRooms(rooms);
+        saveTenants(tenants);
+        saveExpired(handled);
+    }
+    auto list = fresh ? ex.upcoming() : n.upcoming;
+    if(!list.empty()){
+        cout << "Upcoming move-outs (next " << EXPIRY_NOTICE_DAYS << " days):\n";
+        for(auto &info: list) cout << "  " << info.endDate << "  room " << info.roomNo << "  contract " << info.contractID << "  tenant " << info.tenantID << "\n";
+    }
+}
+
 // ---------- Room Management ----------
 void RoomManagement(){
     vector<Room> rooms = loadRooms();
     while(true){
         cout << "\n--- Room Management ---\n";
         cout << "1) Add Room\n2) Edit Room\n3) Delete Room\n4) List All Rooms\n0) Back\nChoose: ";
-        int c; cin >> c;
+        int c = readChoice();
         if(c==0){ saveRooms(rooms); break; }
         if(c==1){
             Room r;
@@ -296,9 +1351,13 @@ void RoomManagement(){
             if(it!=rooms.end()){ rooms.erase(it, rooms.end()); cout << "Deleted.\n"; }
             else cout << "Not found.\n";
         } else if(c==4){
-            cout << left << setw(10) << "RoomNo" << setw(15) << "Type" << setw(12) << "Status" << "\n";
-            cout << string(37,'-') << "\n";
-            for(auto &r: rooms) cout << left << setw(10) << r.roomNo << setw(15) << r.type << setw(12) << r.status << "\n";
+            auto cur = vectorCursor(rooms, askFilter<Room>());
+            browse(cur, []{
+                cout << left << setw(10) << "RoomNo" << setw(15) << "Type" << setw(12) << "Status" << "\n";
+                cout << string(37,'-') << "\n";
+            }, [](const Room &r){
+                cout << left << setw(10) << r.roomNo << setw(15) << r.type << setw(12) << r.status << "\n";
+            });
         } else cout << "Invalid.\n";
     }
 }
@@ -309,7 +1368,7 @@ void TenantManagement(){
     while(true){
         cout << "\n--- Tenant Management ---\n";
         cout << "1) Add Tenant\n2) Edit Tenant\n3) Delete Tenant\n4) Find Tenant\n5) List Tenants\n0) Back\nChoose: ";
-        int c; cin >> c;
+        int c = readChoice();
         if(c==0){ saveTenants(tenants); break; }
         if(c==1){
             Tenant t;
@@ -337,21 +1396,28 @@ void TenantManagement(){
             auto it = remove_if(tenants.begin(), tenants.end(), [&](const Tenant& x){ return x.tenantID==id; });
             if(it!=tenants.end()){ tenants.erase(it, tenants.end()); cout << "Deleted.\n"; } else cout << "Not found.\n";
         } else if(c==4){
-            cout << "Search by (1) Name (2) TenantID (3) RoomNo: "; int s; cin >> s;
+            cout << "Search by (1) Name (2) TenantID (3) RoomNo (4) Filter: "; int s; cin >> s;
             if(s==1){
                 cout << "Enter name: "; string q; cin >> ws; getline(cin,q);
                 for(auto &t: tenants) if(t.name.find(q)!=string::npos) cout << t.tenantID << " | " << t.name << " | " << t.roomNo << "\n";
             } else if(s==2){
                 cout << "Enter TenantID: "; string q; cin >> q;
                 for(auto &t: tenants) if(t.tenantID==q) cout << t.tenantID << " | " << t.name << " | " << t.roomNo << "\n";
+            } else if(s==4){
+                Filter<Tenant> where = askFilter<Tenant>();
+                for(auto &t: tenants) if(where.test(t)) cout << t.tenantID << " | " << t.name << " | " << t.roomNo << "\n";
             } else {
                 cout << "Enter RoomNo: "; string q; cin >> q;
                 for(auto &t: tenants) if(t.roomNo==q) cout << t.tenantID << " | " << t.name << " | " << t.roomNo << "\n";
             }
         } else if(c==5){
-            cout << left << setw(12) << "TenantID" << setw(20) << "Name" << setw(12) << "Phone" << setw(12) << "RoomNo" << "\n";
-            cout << string(56,'-') << "\n";
-            for(auto &t: tenants) cout << left << setw(12) << t.tenantID << setw(20) << t.name << setw(12) << t.phone << setw(12) << t.roomNo << "\n";
+            auto cur = vectorCursor(tenants, askFilter<Tenant>());
+            browse(cur, []{
+                cout << left << setw(12) << "TenantID" << setw(20) << "Name" << setw(12) << "Phone" << setw(12) << "RoomNo" << "\n";
+                cout << string(56,'-') << "\n";
+            }, [](const Tenant &t){
+                cout << left << setw(12) << t.tenantID << setw(20) << t.name << setw(12) << t.phone << setw(12) << t.roomNo << "\n";
+            });
         } else cout << "Invalid.\n";
     }
 }
@@ -361,12 +1427,13 @@ void ContractManagement(){
     vector<Contract> contracts = loadContracts();
     vector<Room> rooms = loadRooms();
     vector<Tenant> tenants = loadTenants();
+    Occupancy occ = buildOccupancy(contracts);
 
     while(true){
         cout << "\n--- Contract Management ---\n";
-        cout << "1) Add Contract\n2) Edit Contract\n3) End/Delete Contract\n4) List Contracts\n0) Back\nChoose: ";
-        int c; cin >> c;
-        if(c==0){ saveContracts(contracts); saveRooms(rooms); break; }
+        cout << "1) Add Contract\n2) Edit Contract\n3) End/Delete Contract\n4) List Contracts\n5) Who Occupied a Room on a Date\n6) Find Free Rooms for a Date Range\n0) Back\nChoose: ";
+        int c = readChoice();
+        if(c==0){ saveContracts(contracts); saveRooms(rooms); saveTenants(tenants); break; }
         if(c==1){
             Contract co;
             co.contractID = genID("C");
@@ -376,6 +1443,12 @@ void ContractManagement(){
             cout << "EndDate (YYYY-MM-DD): "; cin >> co.endDate;
             cout << "RoomPrice: "; cin >> co.roomPrice;
             cout << "InternetFee: "; cin >> co.internetFee;
+            int lo = parseDate(co.startDate), hi = parseDate(co.endDate);
+            if(lo < 0 || hi < lo){ cout << "Invalid date range.\n"; continue; }
+            string clash = findOverlap(occ, co.roomNo, lo, hi);
+            if(clash != ""){ cout << "Room " << co.roomNo << " is already under contract " << clash << " in that period.\n"; continue; }
+            occ[co.roomNo].insert({lo, hi, co.contractID});
+            expiry().track(co);
             // update room status
             Room* pr = findRoom(rooms, co.roomNo);
             if(pr) pr->status = "Occupied";
@@ -388,20 +1461,35 @@ void ContractManagement(){
             Contract* pc = findContract(contracts, id);
             if(!pc) cout << "Not found.\n";
             else {
-                cout << "New EndDate (current " << pc->endDate << "): "; string tmp; cin >> tmp; if(trim(tmp)!="") pc->endDate = tmp;
+                cout << "New EndDate (current " << pc->endDate << "): "; string tmp; cin >> tmp;
+                if(trim(tmp)!="" && tmp!=pc->endDate){
+                    int lo = parseDate(pc->startDate), hi = parseDate(tmp);
+                    string clash = lo >= 0 && hi >= lo ? findOverlap(occ, pc->roomNo, lo, hi, pc->contractID) : "";
+                    if(lo < 0 || hi < lo) cout << "Invalid EndDate, kept " << pc->endDate << ".\n";
+                    else if(clash != "") cout << "Overlaps contract " << clash << ", kept " << pc->endDate << ".\n";
+                    else {
+                        occ[pc->roomNo].erase(lo, pc->contractID);
+                        occ[pc->roomNo].insert({lo, hi, pc->contractID});
+                        pc->endDate = tmp;
+                        expiry().track(*pc);
+                    }
+                }
                 cout << "New RoomPrice (current " << pc->roomPrice << "): "; string tmp2; cin >> tmp2; if(trim(tmp2)!="") pc->roomPrice = stod(tmp2);
                 cout << "New InternetFee (current " << pc->internetFee << "): "; string tmp3; cin >> tmp3; if(trim(tmp3)!="") pc->internetFee = stod(tmp3);
                 cout << "Updated.\n";
             }
         } else if(c==3){
             string id; cout << "ContractID to end/delete: "; cin >> id;
+            if(Contract* pc = findContract(contracts, id)) occ[pc->roomNo].erase(parseDate(pc->startDate), id);
+            expiry().untrack(id);
             auto it = remove_if(contracts.begin(), contracts.end(), [&](const Contract& x){ return x.contractID==id; });
             if(it==contracts.end()){ cout << "Not found.\n"; }
             else {
                 contracts.erase(it, contracts.end());
-                // rebuild room statuses based on remaining contracts:
+                // rebuild room statuses based on remaining (unexpired) contracts:
+                int today = todayDays();
                 for(auto &r: rooms) r.status = "Available";
-                for(auto &c2: contracts) for(auto &r: rooms) if(r.roomNo==c2.roomNo) r.status = "Occupied";
+                for(auto &c2: contracts) if(!expiry().isExpired(c2, today)) for(auto &r: rooms) if(r.roomNo==c2.roomNo) r.status = "Occupied";
                 // clear tenants room if not in any contract
                 for(auto &t: tenants){
                     bool has=false;
@@ -411,13 +1499,40 @@ void ContractManagement(){
                 cout << "Contract removed and statuses updated.\n";
             }
         } else if(c==4){
-            cout << left << setw(12) << "ContractID" << setw(10) << "TenantID" << setw(8) << "RoomNo" 
-                 << setw(12) << "Start" << setw(12) << "End" << setw(10) << "Price" << "\n";
-            cout << string(70,'-') << "\n";
-            for(auto &c2: contracts){
+            auto cur = vectorCursor(contracts, askFilter<Contract>());
+            browse(cur, []{
+                cout << left << setw(12) << "ContractID" << setw(10) << "TenantID" << setw(8) << "RoomNo" 
+                     << setw(12) << "Start" << setw(12) << "End" << setw(10) << "Price" << "\n";
+                cout << string(70,'-') << "\n";
+            }, [](const Contract &c2){
                 cout << left << setw(12) << c2.contractID << setw(10) << c2.tenantID << setw(8) << c2.roomNo 
                      << setw(12) << c2.startDate << setw(12) << c2.endDate << setw(10) << c2.roomPrice << "\n";
+            });
+        } else if(c==5){
+            string rn, date; cout << "RoomNo: "; cin >> rn; cout << "Date (YYYY-MM-DD): "; cin >> date;
+            int d = parseDate(date);
+            if(d < 0){ cout << "Invalid date.\n"; continue; }
+            vector<const IntervalTree::Interval*> hits;
+            if(occ.count(rn)) occ[rn].overlapping(d, d, hits);
+            if(hits.empty()) cout << "Room " << rn << " was free on " << date << ".\n";
+            for(auto iv: hits){
+                Contract* pc = findContract(contracts, iv->id);
+                Tenant* pt = pc ? findTenant(tenants, pc->tenantID) : nullptr;
+                cout << iv->id << " | " << (pc ? pc->tenantID : string("?")) << " | " << (pt ? pt->name : string("-"))
+                     << " | " << (pc ? pc->startDate + " .. " + pc->endDate : string("")) << "\n";
+            }
+        } else if(c==6){
+            string type, from, to;
+            cout << "Type (Single/Double/Suite): "; cin >> ws; getline(cin, type);
+            cout << "From (YYYY-MM-DD): "; cin >> from; cout << "To (YYYY-MM-DD): "; cin >> to;
+            int lo = parseDate(from), hi = parseDate(to);
+            if(lo < 0 || hi < lo){ cout << "Invalid date range.\n"; continue; }
+            int n = 0;
+            for(auto &r: rooms){
+                if(r.type != type || r.status == "Maintenance") continue;
+                if(findOverlap(occ, r.roomNo, lo, hi) == ""){ cout << r.roomNo << "\n"; ++n; }
             }
+            cout << n << " free " << type << " room(s) for " << from << " .. " << to << ".\n";
         } else cout << "Invalid.\n";
     }
 }
@@ -428,7 +1543,7 @@ void UtilityCalculation(){
     while(true){
         cout << "\n--- Utility Calculation ---\n";
         cout << "1) Add/Update Utility Reading\n2) Calculate Units for a Room (month/year)\n3) List Utilities\n0) Back\nChoose: ";
-        int c; cin >> c;
+        int c = readChoice();
         if(c==0){ saveUtilities(utils); break; }
         if(c==1){
             Utility u;
@@ -461,14 +1576,42 @@ void UtilityCalculation(){
             }
             if(!found) cout << "No utility reading for that room/month.\n";
         } else if(c==3){
-            cout << left << setw(8) << "Room" << setw(6) << "MM" << setw(6) << "YYYY" << setw(8) << "PrevW" << setw(8) << "CurW" << setw(8) << "PrevE" << setw(8) << "CurE" << setw(8) << "WRate" << setw(8) << "ERate" << "\n";
-            cout << string(84,'-') << "\n";
-            for(auto &u: utils) cout << left << setw(8) << u.roomNo << setw(6) << u.month << setw(6) << u.year << setw(8) << u.prevWater << setw(8) << u.currWater << setw(8) << u.prevElectric << setw(8) << u.currElectric << setw(8) << u.waterRate << setw(8) << u.electricRate << "\n";
+            auto cur = vectorCursor(utils, askFilter<Utility>());
+            browse(cur, []{
+                cout << left << setw(8) << "Room" << setw(6) << "MM" << setw(6) << "YYYY" << setw(8) << "PrevW" << setw(8) << "CurW" << setw(8) << "PrevE" << setw(8) << "CurE" << setw(8) << "WRate" << setw(8) << "ERate" << "\n";
+                cout << string(84,'-') << "\n";
+            }, [](const Utility &u){
+                cout << left << setw(8) << u.roomNo << setw(6) << u.month << setw(6) << u.year << setw(8) << u.prevWater << setw(8) << u.currWater << setw(8) << u.prevElectric << setw(8) << u.currElectric << setw(8) << u.waterRate << setw(8) << u.electricRate << "\n";
+            });
         } else cout << "Invalid.\n";
     }
 }
 
 // ---------- Invoice Calculation ----------
+Invoice makeInvoice(const Contract &co, const vector<Utility> &utils, const string &mo, const string &yr){
+    double waterBill=0, electricBill=0;
+    for(auto &u: utils) if(u.roomNo==co.roomNo && u.month==mo && u.year==yr){
+        int wUnits = u.currWater - u.prevWater;
+        int eUnits = u.currElectric - u.prevElectric;
+        waterBill = wUnits * u.waterRate;
+        electricBill = eUnits * u.electricRate;
+        break;
+    }
+    Invoice inv;
+    inv.invoiceID = genID("I");
+    inv.contractID = co.contractID;
+    inv.roomNo = co.roomNo;
+    inv.month = mo;
+    inv.year = yr;
+    inv.roomPrice = co.roomPrice;
+    inv.internetFee = co.internetFee;
+    inv.waterBill = waterBill;
+    inv.electricBill = electricBill;
+    inv.total = inv.roomPrice + inv.internetFee + inv.waterBill + inv.electricBill;
+    inv.status = "UNPAID";
+    return inv;
+}
+
 void InvoiceCalculation(){
     vector<Contract> contracts = loadContracts();
     vector<Utility> utils = loadUtilities();
@@ -477,39 +1620,27 @@ void InvoiceCalculation(){
     while(true){
         cout << "\n--- Invoice Calculation ---\n";
         cout << "1) Create Invoice for Contract (month/year)\n2) List Invoices\n0) Back\nChoose: ";
-        int c; cin >> c;
+        int c = readChoice();
         if(c==0){ saveInvoices(invoices); break; }
         if(c==1){
             string cid; cout << "ContractID: "; cin >> cid;
             Contract* pc = findContract(contracts, cid);
             if(!pc){ cout << "Contract not found.\n"; continue; }
             string mo, yr; cout << "Month (MM): "; cin >> mo; cout << "Year (YYYY): "; cin >> yr;
-            double waterBill=0, electricBill=0;
-            for(auto &u: utils) if(u.roomNo==pc->roomNo && u.month==mo && u.year==yr){
-                int wUnits = u.currWater - u.prevWater;
-                int eUnits = u.currElectric - u.prevElectric;
-                waterBill = wUnits * u.waterRate;
-                electricBill = eUnits * u.electricRate;
-                break;
-            }
-            Invoice inv;
-            inv.invoiceID = genID("I");
-            inv.contractID = pc->contractID;
-            inv.roomNo = pc->roomNo;
-            inv.month = mo;
-            inv.year = yr;
-            inv.roomPrice = pc->roomPrice;
-            inv.internetFee = pc->internetFee;
-            inv.waterBill = waterBill;
-            inv.electricBill = electricBill;
-            inv.total = inv.roomPrice + inv.internetFee + inv.waterBill + inv.electricBill;
-            inv.status = "UNPAID";
+            int end = parseDate(pc->endDate);
+            int first = parseDate(yr + "-" + mo + "-01");
+            if(end >= 0 && first > end){ cout << "Contract ended on " << pc->endDate << "; no invoice created.\n"; continue; }
+            Invoice inv = makeInvoice(*pc, utils, mo, yr);
             invoices.push_back(inv);
             cout << "Invoice created ID: " << inv.invoiceID << " Total: " << inv.total << "\n";
         } else if(c==2){
-            cout << left << setw(10) << "InvoiceID" << setw(10) << "Contract" << setw(8) << "Room" << setw(8) << "MM" << setw(8) << "YYYY" << setw(10) << "Total" << setw(8) << "Status" << "\n";
-            cout << string(70,'-') << "\n";
-            for(auto &inv: invoices) cout << left << setw(10) << inv.invoiceID << setw(10) << inv.contractID << setw(8) << inv.roomNo << setw(8) << inv.month << setw(8) << inv.year << setw(10) << inv.total << setw(8) << inv.status << "\n";
+            auto cur = vectorCursor(invoices, askFilter<Invoice>());
+            browse(cur, []{
+                cout << left << setw(10) << "InvoiceID" << setw(10) << "Contract" << setw(8) << "Room" << setw(8) << "MM" << setw(8) << "YYYY" << setw(10) << "Total" << setw(8) << "Status" << "\n";
+                cout << string(70,'-') << "\n";
+            }, [](const Invoice &inv){
+                cout << left << setw(10) << inv.invoiceID << setw(10) << inv.contractID << setw(8) << inv.roomNo << setw(8) << inv.month << setw(8) << inv.year << setw(10) << inv.total << setw(8) << inv.status << "\n";
+            });
         } else cout << "Invalid.\n";
     }
 }
@@ -521,7 +1652,7 @@ void PaymentChecking(){
     while(true){
         cout << "\n--- Payment Checking ---\n";
         cout << "1) Find Invoice\n2) Mark Invoice PAID\n3) List Payments\n0) Back\nChoose: ";
-        int c; cin >> c;
+        int c = readChoice();
         if(c==0){ saveInvoices(invoices); savePayments(payments); break; }
         if(c==1){
             string id; cout << "InvoiceID: "; cin >> id;
@@ -541,9 +1672,13 @@ void PaymentChecking(){
             payments.push_back(Payment{id, amt, date});
             cout << "Marked PAID and recorded payment.\n";
         } else if(c==3){
-            cout << left << setw(12) << "InvoiceID" << setw(10) << "Amount" << setw(12) << "Date" << "\n";
-            cout << string(36,'-') << "\n";
-            for(auto &p: payments) cout << left << setw(12) << p.invoiceID << setw(10) << p.amount << setw(12) << p.date << "\n";
+            auto cur = vectorCursor(payments, askFilter<Payment>());
+            browse(cur, []{
+                cout << left << setw(12) << "InvoiceID" << setw(10) << "Amount" << setw(12) << "Date" << "\n";
+                cout << string(36,'-') << "\n";
+            }, [](const Payment &p){
+                cout << left << setw(12) << p.invoiceID << setw(10) << p.amount << setw(12) << p.date << "\n";
+            });
         } else cout << "Invalid.\n";
     }
 }
@@ -554,7 +1689,7 @@ void AdminManagement(){
     while(true){
         cout << "\n--- Admin Management ---\n";
         cout << "1) Create Admin\n2) Edit Admin Password\n3) Delete Admin\n4) List Admins\n0) Back\nChoose: ";
-        int c; cin >> c;
+        int c = readChoice();
         if(c==0){ saveAdmins(admins); break; }
         if(c==1){
             Admin a;
@@ -583,7 +1718,6 @@ void AdminManagement(){
 // ---------- User Management (Tenant View) ----------
 void UserManagement(){
     vector<Tenant> tenants = loadTenants();
-    vector<Invoice> invoices = loadInvoices();
     cout << "\n--- Tenant (User) View ---\n";
     cout << "Enter your TenantID: "; string id; cin >> id;
     Tenant* pt = findTenant(tenants, id);
@@ -591,128 +1725,652 @@ void UserManagement(){
     cout << "Welcome, " << pt->name << " Room: " << pt->roomNo << "\n";
     while(true){
         cout << "1) View Profile\n2) View My Invoices\n0) Back\nChoose: ";
-        int c; cin >> c;
+        int c = readChoice();
         if(c==0) break;
         if(c==1){
             cout << "TenantID: " << pt->tenantID << "\nName: " << pt->name << "\nPhone: " << pt->phone << "\nCitizenID: " << pt->citizenID << "\nBirthDate: " << pt->birthDate << "\nAddress: " << pt->address << "\nRoomNo: " << pt->roomNo << "\n";
         } else if(c==2){
-            cout << left << setw(10) << "InvoiceID" << setw(10) << "MM" << setw(10) << "YYYY" << setw(10) << "Total" << setw(8) << "Status" << "\n";
-            cout << string(48,'-') << "\n";
-            for(auto &inv: invoices) if(inv.roomNo==pt->roomNo) cout << left << setw(10) << inv.invoiceID << setw(10) << inv.month << setw(10) << inv.year << setw(10) << inv.total << setw(8) << inv.status << "\n";
+            // streamed from Invoice.dat; only this room's rows are built, one page at a time
+            Filter<Invoice> where = askFilter<Invoice>();
+            if(where.empty()) where.anyOf.emplace_back();
+            for(auto &group: where.anyOf) group.push_back(Cond{(size_t)Table<Invoice>::fieldIndex("roomNo"), "=", pt->roomNo, 0, false});
+            auto cur = fileCursor(dataPath(INVOICE_FILE), where);
+            browse(cur, []{
+                cout << left << setw(10) << "InvoiceID" << setw(10) << "MM" << setw(10) << "YYYY" << setw(10) << "Total" << setw(8) << "Status" << "\n";
+                cout << string(48,'-') << "\n";
+            }, [](const Invoice &inv){
+                cout << left << setw(10) << inv.invoiceID << setw(10) << inv.month << setw(10) << inv.year << setw(10) << inv.total << setw(8) << inv.status << "\n";
+            });
         } else cout << "Invalid.\n";
     }
 }
 
 // ---------- Report Management ----------
-void ReportManagement(){
+// Per-month totals for one building; merge() folds other buildings in.
+struct MonthlyReport {
+    struct Usage {
+        double sumW = 0, sumE = 0;
+        size_t n = 0;
+        int maxW = 0, maxE = 0;
+    };
+    map<string, double> incomeByMonth;   // key = MM/YYYY, from payment dates
+    map<string, double> invoicedByMonth; // key = MM/YYYY, from invoice month
+    map<string, Usage> utilStats;        // units per room-month
+
+    void merge(const MonthlyReport &o){
+        for(auto &p: o.incomeByMonth) incomeByMonth[p.first] += p.second;
+        for(auto &p: o.invoicedByMonth) invoicedByMonth[p.first] += p.second;
+        for(auto &p: o.utilStats){
+            Usage &u = utilStats[p.first];
+            u.maxW = u.n ? max(u.maxW, p.second.maxW) : p.second.maxW;
+            u.maxE = u.n ? max(u.maxE, p.second.maxE) : p.second.maxE;
+            u.sumW += p.second.sumW; u.sumE += p.second.sumE; u.n += p.second.n;
+        }
+    }
+};
+
+MonthlyReport computeReport(const string &building){
+    MonthlyReport r;
     // Load payments (to compute actual received income by payment.date)
-    vector<Payment> payments = loadPayments();
-    vector<Invoice> invoices = loadInvoices();
-    vector<Utility> utils = loadUtilities();
+    // pinned snapshots: edits published while the report runs are not seen
+    auto payments = pinTable<Payment>(shardPath(building, PAYMENT_FILE));
+    auto invoices = pinTable<Invoice>(shardPath(building, INVOICE_FILE));
+    auto utils = pinTable<Utility>(shardPath(building, UTILITY_FILE));
 
-    // monthly income from payments (by payment date YYYY-MM-DD)
-    map<string, double> incomeByMonth; // key = MM/YYYY
-    for(auto &p: payments){
+    for(auto &p: *payments){
         if(p.date.size() >= 7){
             // expect YYYY-MM-DD -> take MM and YYYY
             string year = p.date.substr(0,4);
             string month = p.date.substr(5,2);
-            string key = month + "/" + year;
-            incomeByMonth[key] += p.amount;
+            r.incomeByMonth[month + "/" + year] += p.amount;
         }
     }
     // Also include unpaid invoices? We'll compute "invoiced" totals separately
-    map<string, double> invoicedByMonth;
-    for(auto &inv: invoices){
-        string key = inv.month + "/" + inv.year;
-        invoicedByMonth[key] += inv.total;
-    }
+    for(auto &inv: *invoices) r.invoicedByMonth[inv.month + "/" + inv.year] += inv.total;
 
-    // Utility stats per month (aggregate units per room-month)
-    struct Stat { vector<int> waterUnits; vector<int> electricUnits; };
-    map<string, Stat> utilStats;
-    for(auto &u: utils){
-        string key = u.month + "/" + u.year;
+    for(auto &u: *utils){
+        auto &st = r.utilStats[u.month + "/" + u.year];
         int w = u.currWater - u.prevWater;
         int e = u.currElectric - u.prevElectric;
-        utilStats[key].waterUnits.push_back(w);
-        utilStats[key].electricUnits.push_back(e);
+        st.maxW = st.n ? max(st.maxW, w) : w;
+        st.maxE = st.n ? max(st.maxE, e) : e;
+        st.sumW += w; st.sumE += e; st.n++;
     }
+    return r;
+}
 
-    // Print report header
-    cout << "\n========== Monthly Report ==========\n";
-    cout << left << setw(10) << "Month" << setw(15) << "Invoiced" << setw(15) << "Received" << setw(12) << "AvgW" << setw(12) << "AvgE" << setw(10) << "MaxW" << setw(10) << "MaxE" << "\n";
-    cout << string(84,'-') << "\n";
+void printReport(ostream &out, const MonthlyReport &r){
+    out << left << setw(10) << "Month" << setw(15) << "Invoiced" << setw(15) << "Received" << setw(12) << "AvgW" << setw(12) << "AvgE" << setw(10) << "MaxW" << setw(10) << "MaxE" << "\n";
+    out << string(84,'-') << "\n";
 
     // Build set of all months present
     set<string> months;
-    for(auto &p: incomeByMonth) months.insert(p.first);
-    for(auto &p: invoicedByMonth) months.insert(p.first);
-    for(auto &p: utilStats) months.insert(p.first);
+    for(auto &p: r.incomeByMonth) months.insert(p.first);
+    for(auto &p: r.invoicedByMonth) months.insert(p.first);
+    for(auto &p: r.utilStats) months.insert(p.first);
 
     for(auto &m: months){
-        double invoiced = invoicedByMonth.count(m) ? invoicedByMonth[m] : 0.0;
-        double received = incomeByMonth.count(m) ? incomeByMonth[m] : 0.0;
-        double avgW=0, avgE=0; int maxW=0, maxE=0, minW=0, minE=0;
-        if(utilStats.count(m)){
-            auto &vecW = utilStats[m].waterUnits;
-            auto &vecE = utilStats[m].electricUnits;
-            if(!vecW.empty()){
-                avgW = accumulate(vecW.begin(), vecW.end(), 0.0) / vecW.size();
-                maxW = *max_element(vecW.begin(), vecW.end());
-                minW = *min_element(vecW.begin(), vecW.end());
-            }
-            if(!vecE.empty()){
-                avgE = accumulate(vecE.begin(), vecE.end(), 0.0) / vecE.size();
-                maxE = *max_element(vecE.begin(), vecE.end());
-                minE = *min_element(vecE.begin(), vecE.end());
-            }
+        auto inv = r.invoicedByMonth.find(m);
+        auto rec = r.incomeByMonth.find(m);
+        double invoiced = inv != r.invoicedByMonth.end() ? inv->second : 0.0;
+        double received = rec != r.incomeByMonth.end() ? rec->second : 0.0;
+        double avgW=0, avgE=0; int maxW=0, maxE=0;
+        auto st = r.utilStats.find(m);
+        if(st != r.utilStats.end() && st->second.n){
+            avgW = st->second.sumW / st->second.n;
+            avgE = st->second.sumE / st->second.n;
+            maxW = st->second.maxW;
+            maxE = st->second.maxE;
         }
-        cout << left << setw(10) << m << setw(15) << fixed << setprecision(2) << invoiced << setw(15) << fixed << setprecision(2) << received
-             << setw(12) << (avgW>0? to_string((int)round(avgW)) : string("-"))
-             << setw(12) << (avgE>0? to_string((int)round(avgE)) : string("-"))
-             << setw(10) << (maxW>0? to_string(maxW) : string("-"))
-             << setw(10) << (maxE>0? to_string(maxE) : string("-"))
-             << "\n";
+        out << left << setw(10) << m << setw(15) << fixed << setprecision(2) << invoiced << setw(15) << fixed << setprecision(2) << received
+            << setw(12) << (avgW>0? to_string((int)round(avgW)) : string("-"))
+            << setw(12) << (avgE>0? to_string((int)round(avgE)) : string("-"))
+            << setw(10) << (maxW>0? to_string(maxW) : string("-"))
+            << setw(10) << (maxE>0? to_string(maxE) : string("-"))
+            << "\n";
     }
-    cout << string(84,'-') << "\n";
+    out << string(84,'-') << "\n";
+}
+
+// Report files go through the Persister like the tables, so the foreground
+// and background reports never interleave and a reader never sees half a
+// file. Returns once the file is in place, false if it could not be written.
+bool saveReport(const string &file, const string &text){
+    Persister::instance().submit(file, [text](const string &path){
+        ofstream rf(path, ios::trunc);
+        rf << text;
+        rf.close();
+        return !rf.fail();
+    });
+    return Persister::instance().waitFor(file);
+}
+
+void ReportManagement(){
+    MonthlyReport r = computeReport(currentBuilding);
+
+    // Print report header
+    cout << "\n========== Monthly Report ==========\n";
+    printReport(cout, r);
 
     // Save textual report file
-    ofstream rf(REPORT_FILE, ios::trunc);
+    ostringstream rf;
     rf << "========== Monthly Report ==========\n";
-    rf << left << setw(10) << "Month" << setw(15) << "Invoiced" << setw(15) << "Received" << setw(12) << "AvgW" << setw(12) << "AvgE" << setw(10) << "MaxW" << setw(10) << "MaxE" << "\n";
-    rf << string(84,'-') << "\n";
-    for(auto &m: months){
-        double invoiced = invoicedByMonth.count(m) ? invoicedByMonth[m] : 0.0;
-        double received = incomeByMonth.count(m) ? incomeByMonth[m] : 0.0;
-        double avgW=0, avgE=0; int maxW=0, maxE=0;
-        if(utilStats.count(m)){
-            auto &vecW = utilStats[m].waterUnits;
-            auto &vecE = utilStats[m].electricUnits;
-            if(!vecW.empty()){
-                avgW = accumulate(vecW.begin(), vecW.end(), 0.0) / vecW.size();
-                maxW = *max_element(vecW.begin(), vecW.end());
+    printReport(rf, r);
+    if(saveReport(dataPath(REPORT_FILE), rf.str())) cout << "Report saved to '" << dataPath(REPORT_FILE) << "'\n";
+    else cout << "Could not save report to '" << dataPath(REPORT_FILE) << "'\n";
+}
+
+// Report computed on a worker thread from pinned snapshots, so editing can
+// continue meanwhile. The result is announced on the next menu return.
+future<string> backgroundReport;
+
+void StartBackgroundReport(){
+    if(backgroundReport.valid()){ cout << "A background report is already running.\n"; return; }
+    string building = currentBuilding;
+    backgroundReport = async(launch::async, [building]{
+        MonthlyReport r = computeReport(building);
+        string file = shardPath(building, REPORT_FILE);
+        ostringstream rf;
+        rf << "========== Monthly Report ==========\n";
+        printReport(rf, r);
+        if(!saveReport(file, rf.str())) return "Background report for " + buildingLabel(building) + " could not be saved to '" + file + "'";
+        return "Background report for " + buildingLabel(building) + " saved to '" + file + "'";
+    });
+    cout << "Report started in background.\n";
+}
+void CollectBackgroundReport(bool wait){
+    if(!backgroundReport.valid()) return;
+    if(!wait && backgroundReport.wait_for(chrono::seconds(0)) != future_status::ready) return;
+    cout << backgroundReport.get() << "\n";
+}
+
+// ---------- Group (All Buildings) ----------
+void GroupManagement(){
+    while(true){
+        vector<string> buildings = listBuildings();
+        cout << "\n--- All Buildings (" << buildings.size() << ") ---\n";
+        cout << "1) Group Monthly Report\n2) Find Tenant in All Buildings\n3) Batch Billing for a Month\n0) Back\nChoose: ";
+        int c = readChoice();
+        if(c==0) break;
+        if(c==1){
+            auto parts = forEachBuilding(buildings, [](const string &b){ return computeReport(b); });
+            MonthlyReport total;
+            for(auto &p: parts) total.merge(p);
+            cout << "\n========== Group Monthly Report ==========\n";
+            printReport(cout, total);
+            ostringstream rf;
+            rf << "========== Group Monthly Report ==========\n";
+            for(auto &b: buildings) rf << "Building: " << buildingLabel(b) << "\n";
+            printReport(rf, total);
+            if(saveReport(GROUP_REPORT_FILE, rf.str())) cout << "Report saved to '" << GROUP_REPORT_FILE << "'\n";
+            else cout << "Could not save report to '" << GROUP_REPORT_FILE << "'\n";
+        } else if(c==2){
+            cout << "Enter name: "; string q; cin >> ws; getline(cin,q);
+            auto parts = forEachBuilding(buildings, [q](const string &b){
+                Filter<Tenant> where;
+                where.anyOf.push_back({Cond{(size_t)Table<Tenant>::fieldIndex("name"), "~", q, 0, false}});
+                return loadTable<Tenant>(shardPath(b, TENANT_FILE), where);
+            });
+            size_t n = 0;
+            for(size_t i=0;i<buildings.size();++i)
+                for(auto &t: parts[i]){
+                    cout << buildingLabel(buildings[i]) << " | " << t.tenantID << " | " << t.name << " | " << t.roomNo << "\n";
+                    ++n;
+                }
+            cout << n << " tenant(s) found.\n";
+        } else if(c==3){
+            string mo, yr; cout << "Month (MM): "; cin >> mo; cout << "Year (YYYY): "; cin >> yr;
+            int first = parseDate(yr + "-" + mo + "-01");
+            if(first < 0){ cout << "Invalid month.\n"; continue; }
+            int m = stoi(mo), y = stoi(yr);
+            char next[32]; snprintf(next, sizeof(next), "%04d-%02d-01", m==12 ? y+1 : y, m==12 ? 1 : m+1);
+            int last = parseDate(next) - 1;
+            // bill every contract running in that month that has no invoice for it yet
+            auto counts = forEachBuilding(buildings, [mo, yr, first, last](const string &b){
+                vector<Contract> contracts = loadTable<Contract>(shardPath(b, CONTRACT_FILE), {});
+                vector<Utility> utils = loadTable<Utility>(shardPath(b, UTILITY_FILE), {});
+                vector<Invoice> invoices = loadTable<Invoice>(shardPath(b, INVOICE_FILE), {});
+                set<string> billed;
+                for(auto &inv: invoices) if(inv.month==mo && inv.year==yr) billed.insert(inv.contractID);
+                size_t created = 0;
+                for(auto &co: contracts){
+                    int lo = parseDate(co.startDate), hi = parseDate(co.endDate);
+                    if(lo < 0 || hi < 0 || lo > last || hi < first || billed.count(co.contractID)) continue;
+                    invoices.push_back(makeInvoice(co, utils, mo, yr));
+                    ++created;
+                }
+                if(created) saveTable(shardPath(b, INVOICE_FILE), invoices);
+                return created;
+            });
+            size_t total = 0;
+            for(size_t i=0;i<buildings.size();++i){
+                cout << left << setw(20) << buildingLabel(buildings[i]) << counts[i] << " invoice(s)\n";
+                total += counts[i];
             }
-            if(!vecE.empty()){
-                avgE = accumulate(vecE.begin(), vecE.end(), 0.0) / vecE.size();
-                maxE = *max_element(vecE.begin(), vecE.end());
+            cout << "Created " << total << " invoice(s) for " << mo << "/" << yr << ".\n";
+        } else cout << "Invalid.\n";
+    }
+}
+
+// ---------- Building Selection ----------
+void SelectBuilding(){
+    vector<string> buildings = listBuildings();
+    cout << "\n--- Buildings ---\n";
+    for(auto &b: buildings) cout << (b==currentBuilding ? "* " : "  ") << buildingLabel(b) << "\n";
+    cout << "Building name (new name creates it, '-' for default): ";
+    string name; cin >> name;
+    if(name=="-") name = "";
+    if(!validBuildingName(name)){ cout << "Invalid name.\n"; return; }
+    if(!name.empty()){
+        error_code ec;
+        filesystem::create_directories(BUILDINGS_DIR + "/" + name, ec);
+        if(ec){ cout << "Could not create building: " << ec.message() << "\n"; return; }
+    }
+    currentBuilding = name;
+    cout << "Now managing building " << buildingLabel(currentBuilding) << ".\n";
+}
+
+// ---------- Workload Driver ----------
+// Replays scripted front-desk sessions against the real menus by feeding
+// their cin from a string, and times each operation end to end.
+//   dorm_system --workload [--ops N] [--rate OPS_PER_SEC] [--mix op=w,...]
+//                          [--seed S] [--windows K] [--building NAME]
+//                          [--record FILE | --script FILE] [--keep]
+// A script line is: op <TAB> main-menu number <TAB> input (newlines as \n).
+// Inputs refer to IDs created earlier in the run as ${T:n}, ${C:n}, ${I:n}
+// (n-th tenant/contract/invoice), so a recorded script replays on fresh data.
+// Runs inside WORKLOAD_DIR, a data root of its own, so its tables never show
+// up in the real buildings or in group operations.
+const string WORKLOAD_DIR = "workload_data";
+
+struct WorkloadOp {
+    string name;
+    int menu;
+    string input;
+};
+const vector<string> WORKLOAD_OPS = {"add_room", "add_tenant", "contract", "reading", "bill", "pay", "search", "list", "report"};
+
+void workloadUsage(){
+    cerr << "usage: dorm_system --workload [--ops N] [--rate OPS_PER_SEC] [--mix op=w,...]\n"
+         << "                   [--seed S] [--windows K] [--building NAME]\n"
+         << "                   [--record FILE | --script FILE] [--keep]\n"
+         << "ops:";
+    for(auto &op: WORKLOAD_OPS) cerr << " " << op;
+    cerr << "\n";
+}
+
+void runMenu(int menu){
+    switch(menu){
+        case 1: RoomManagement(); break;
+        case 2: TenantManagement(); break;
+        case 3: ContractManagement(); break;
+        case 4: UtilityCalculation(); break;
+        case 5: InvoiceCalculation(); break;
+        case 6: PaymentChecking(); break;
+        case 7: UserManagement(); break;
+        case 8: ReportManagement(); break;
+        case 9: AdminManagement(); break;
+    }
+}
+
+// Builds a random session step by step, tracking only how many of each
+// entity it has created so the inputs stay symbolic.
+class WorkloadGenerator {
+public:
+    WorkloadGenerator(map<string, int> mix, unsigned seed) : mix(move(mix)), rng(seed) {}
+
+    WorkloadOp next(){
+        int total = 0;
+        for(auto &m: mix) total += m.second;
+        int pick = uniform_int_distribution<int>(0, max(total-1, 0))(rng);
+        string op = mix.begin()->first;
+        for(auto &m: mix){ if(pick < m.second){ op = m.first; break; } pick -= m.second; }
+        return make(op);
+    }
+
+private:
+    WorkloadOp make(const string &op){
+        // fall back to the step that unlocks op when its inputs do not exist yet
+        if(op=="contract" && (tenants==0 || freeRooms.empty())) return make(tenants==0 ? "add_tenant" : "add_room");
+        if((op=="reading" || op=="bill") && contracted.empty()) return make("contract");
+        if(op=="pay" && unpaid.empty()) return make("bill");
+        if(op=="search" && tenants==0) return make("add_tenant");
+
+        stringstream in;
+        if(op=="add_room"){
+            string rn = "W" + to_string(rooms++);
+            freeRooms.push_back(rn);
+            in << "1\n" << rn << "\n" << (rooms%2 ? "Single" : "Double") << "\nAvailable\n0\n";
+            return {op, 1, in.str()};
+        }
+        if(op=="add_tenant"){
+            int n = tenants++;
+            in << "1\nTenant " << n << "\n08" << n << "\n" << 1000000 + n << "\n1990-01-01\n" << n << " Main Road\n-\n0\n";
+            return {op, 2, in.str()};
+        }
+        if(op=="contract"){
+            string rn = freeRooms.back(); freeRooms.pop_back();
+            int t = uniform_int_distribution<int>(0, tenants-1)(rng);
+            contracted.push_back({rn, contracts++});
+            in << "1\n${T:" << t << "}\n" << rn << "\n2025-01-01\n2025-12-31\n4500\n300\n0\n";
+            return {op, 3, in.str()};
+        }
+        if(op=="reading"){
+            auto &rc = contracted[uniform_int_distribution<size_t>(0, contracted.size()-1)(rng)];
+            int mo = uniform_int_distribution<int>(1, 12)(rng);
+            in << "1\n" << rc.first << "\n" << setw(2) << setfill('0') << mo << setfill(' ') << "\n2025\n10\n20\n100\n250\n18\n7.5\n0\n";
+            return {op, 4, in.str()};
+        }
+        if(op=="bill"){
+            auto &rc = contracted[uniform_int_distribution<size_t>(0, contracted.size()-1)(rng)];
+            int mo = uniform_int_distribution<int>(1, 12)(rng);
+            unpaid.push_back(invoices++);
+            in << "1\n${C:" << rc.second << "}\n" << setw(2) << setfill('0') << mo << setfill(' ') << "\n2025\n0\n";
+            return {op, 5, in.str()};
+        }
+        if(op=="pay"){
+            size_t k = uniform_int_distribution<size_t>(0, unpaid.size()-1)(rng);
+            int inv = unpaid[k];
+            unpaid.erase(unpaid.begin()+k);
+            in << "2\n${I:" << inv << "}\n4800\n2025-03-05\n0\n";
+            return {op, 6, in.str()};
+        }
+        if(op=="search"){
+            in << "4\n1\nTenant " << uniform_int_distribution<int>(0, tenants-1)(rng) << "\n0\n";
+            return {op, 2, in.str()};
+        }
+        if(op=="list") return {op, 5, "2\n\nq\n0\n"};
+        return {"report", 8, ""};
+    }
+
+    map<string, int> mix;
+    mt19937 rng;
+    int rooms = 0, tenants = 0, contracts = 0, invoices = 0;
+    vector<string> freeRooms;
+    vector<pair<string,int>> contracted; // roomNo, contract index
+    vector<int> unpaid;                  // invoice indexes
+};
+
+string escapeInput(const string &in){
+    string out;
+    for(char ch: in){ if(ch=='\n') out += "\\n"; else if(ch=='\\') out += "\\\\"; else out += ch; }
+    return out;
+}
+string unescapeInput(const string &in){
+    string out;
+    for(size_t i=0;i<in.size();++i){
+        if(in[i]=='\\' && i+1<in.size()){ ++i; out += in[i]=='n' ? '\n' : in[i]; }
+        else out += in[i];
+    }
+    return out;
+}
+
+double percentile(vector<double> v, double p){
+    if(v.empty()) return 0;
+    sort(v.begin(), v.end());
+    size_t k = (size_t)ceil(p / 100.0 * v.size());
+    return v[k ? k-1 : 0];
+}
+
+int WorkloadMain(int argc, char* argv[]){
+    size_t ops = 1000, windows = 4;
+    double rate = 0;
+    unsigned seed = 1;
+    bool keep = false;
+    string record, script, building;
+    map<string, int> mix = {{"add_room",10},{"add_tenant",15},{"contract",10},{"reading",20},{"bill",15},{"pay",15},{"search",5},{"list",5},{"report",5}};
+    auto bad = [](const string &what){ cerr << what << "\n"; workloadUsage(); return 1; };
+    for(int i=2;i<argc;++i){
+        string a = argv[i];
+        string v = i+1<argc ? argv[i+1] : "";
+        if(a=="--ops"){ if(!parseValue(v, ops)) return bad("Bad --ops: " + v); ++i; }
+        else if(a=="--rate"){ if(!parseValue(v, rate) || rate < 0) return bad("Bad --rate: " + v); ++i; }
+        else if(a=="--seed"){ if(!parseValue(v, seed)) return bad("Bad --seed: " + v); ++i; }
+        else if(a=="--windows"){ if(!parseValue(v, windows) || windows == 0) return bad("Bad --windows: " + v); ++i; }
+        else if(a=="--building"){
+            building = v; ++i;
+            if(!validBuildingName(building)){ cerr << "Invalid building name: " << building << "\n"; return 1; }
+        }
+        else if(a=="--record"){ record = v; ++i; }
+        else if(a=="--script"){ script = v; ++i; }
+        else if(a=="--keep") keep = true;
+        else if(a=="--mix"){
+            mix.clear();
+            int total = 0;
+            for(auto &kv: split(v, ',')){
+                auto p = split(kv, '=');
+                int w;
+                if(p.size()!=2 || !parseValue(trim(p[1]), w) || w < 0) return bad("Bad --mix entry (want op=weight): " + kv);
+                string op = trim(p[0]);
+                if(find(WORKLOAD_OPS.begin(), WORKLOAD_OPS.end(), op) == WORKLOAD_OPS.end()) return bad("Unknown op in --mix: " + op);
+                mix[op] = w;
+                total += w;
             }
+            if(total <= 0) return bad("--mix needs at least one op with weight > 0");
+            ++i;
+        } else return bad("Unknown option " + a);
+    }
+
+    vector<WorkloadOp> plan;
+    if(!script.empty()){
+        ifstream f(script);
+        if(!f) return bad("Cannot read script " + script);
+        string line;
+        for(size_t n = 1; getline(f, line); ++n){
+            if(line.empty()) continue;
+            auto p = split(line, '\t');
+            int menu;
+            if(p.size() < 2 || !parseValue(p[1], menu) || menu < 1 || menu > 9)
+                return bad(script + ":" + to_string(n) + ": want op <TAB> menu 1-9 <TAB> input");
+            plan.push_back({p[0], menu, p.size() > 2 ? unescapeInput(p[2]) : ""});
         }
-        rf << left << setw(10) << m << setw(15) << fixed << setprecision(2) << invoiced << setw(15) << fixed << setprecision(2) << received
-           << setw(12) << (avgW>0? to_string((int)round(avgW)) : string("-"))
-           << setw(12) << (avgE>0? to_string((int)round(avgE)) : string("-"))
-           << setw(10) << (maxW>0? to_string(maxW) : string("-"))
-           << setw(10) << (maxE>0? to_string(maxE) : string("-"))
-           << "\n";
+    } else {
+        WorkloadGenerator gen(mix, seed);
+        for(size_t i=0;i<ops;++i) plan.push_back(gen.next());
     }
-    rf << string(84,'-') << "\n";
-    rf.close();
+    if(!record.empty()){
+        ofstream f(record, ios::trunc);
+        for(auto &op: plan) f << op.name << "\t" << op.menu << "\t" << escapeInput(op.input) << "\n";
+    }
+
+    error_code ec;
+    filesystem::create_directories(WORKLOAD_DIR, ec);
+    filesystem::current_path(WORKLOAD_DIR, ec);
+    if(ec){ cerr << "Cannot use " << WORKLOAD_DIR << ": " << ec.message() << "\n"; return 1; }
+    currentBuilding = building;
+    filesystem::create_directories(shardPath(building, ""), ec);
+    if(!keep) for(auto &f: {ROOM_FILE, TENANT_FILE, CONTRACT_FILE, UTILITY_FILE, INVOICE_FILE, PAYMENT_FILE, EXPIRED_FILE}) remove(dataPath(f).c_str());
 
-    cout << "Report saved to '" << REPORT_FILE << "'\n";
+    map<char, vector<string>> created; // 'T'/'C'/'I' -> IDs in creation order
+    auto substitute = [&](const string &in){
+        string out;
+        for(size_t i=0;i<in.size();++i){
+            size_t close = in.find('}', i);
+            if(in.compare(i, 2, "${")==0 && close != string::npos && i+4 < close && in[i+3]==':'){
+                auto &ids = created[in[i+2]];
+                size_t n = stoul(in.substr(i+4, close-i-4));
+                out += n < ids.size() ? ids[n] : "?";
+                i = close;
+            } else out += in[i];
+        }
+        return out;
+    };
+    auto capture = [&](const string &out, const string &marker, char kind){
+        size_t p = out.find(marker);
+        if(p == string::npos) return;
+        stringstream ss(out.substr(p + marker.size()));
+        string id; ss >> id;
+        created[kind].push_back(id);
+    };
+
+    struct Sample { string op; size_t index; double ms; };
+    vector<Sample> samples;
+    samples.reserve(plan.size());
+    auto *cinBuf = cin.rdbuf();
+    auto *coutBuf = cout.rdbuf();
+    auto start = chrono::steady_clock::now();
+    for(size_t i=0;i<plan.size();++i){
+        auto &op = plan[i];
+        // with a target rate, latency counts from the scheduled start (no coordinated omission)
+        auto begin = chrono::steady_clock::now();
+        if(rate > 0){
+            begin = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(i / rate));
+            this_thread::sleep_until(begin);
+        }
+        istringstream in(substitute(op.input) + "0\n");
+        ostringstream out;
+        cin.rdbuf(in.rdbuf());
+        cout.rdbuf(out.rdbuf());
+        runMenu(op.menu);
+        cin.rdbuf(cinBuf);
+        cout.rdbuf(coutBuf);
+        cin.clear();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        samples.push_back({op.name, i, ms});
+
+        string text = out.str();
+        if(op.name=="add_tenant") capture(text, "Added Tenant ID = ", 'T');
+        else if(op.name=="contract") capture(text, "Contract added ID: ", 'C');
+        else if(op.name=="bill") capture(text, "Invoice created ID: ", 'I');
+    }
+    double runSec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    auto flushStart = chrono::steady_clock::now();
+    Persister::instance().flush();
+    double flushMs = chrono::duration<double, milli>(chrono::steady_clock::now() - flushStart).count();
+
+    map<string, vector<double>> byOp;
+    for(auto &smp: samples) byOp[smp.op].push_back(smp.ms);
+    cout << "\n========== Workload (" << plan.size() << " ops, building " << buildingLabel(building) << ") ==========\n";
+    cout << left << setw(12) << "Operation" << right << setw(8) << "Count" << setw(10) << "p50 ms" << setw(10) << "p95 ms" << setw(10) << "p99 ms" << setw(10) << "max ms" << "\n";
+    cout << string(60,'-') << "\n";
+    cout << fixed << setprecision(3);
+    for(auto &b: byOp){
+        cout << left << setw(12) << b.first << right << setw(8) << b.second.size()
+             << setw(10) << percentile(b.second, 50) << setw(10) << percentile(b.second, 95)
+             << setw(10) << percentile(b.second, 99) << setw(10) << percentile(b.second, 100) << "\n";
+    }
+    cout << string(60,'-') << "\n";
+    cout << "Throughput: " << (runSec > 0 ? plan.size() / runSec : 0) << " ops/s over " << runSec << " s; final flush " << flushMs << " ms\n";
+
+    // p95 per op for each slice of the run, to show how latency grows with the tables
+    cout << "\np95 ms by run segment (" << windows << " segments)\n";
+    cout << left << setw(12) << "Operation";
+    for(size_t w=0; w<windows; ++w) cout << right << setw(10) << ("#" + to_string(w+1));
+    cout << "\n";
+    for(auto &b: byOp){
+        cout << left << setw(12) << b.first;
+        for(size_t w=0; w<windows; ++w){
+            vector<double> part;
+            for(auto &smp: samples)
+                if(smp.op==b.first && smp.index * windows / max<size_t>(plan.size(), 1) == w) part.push_back(smp.ms);
+            if(part.empty()) cout << right << setw(10) << "-";
+            else cout << right << setw(10) << percentile(part, 95);
+        }
+        cout << "\n";
+    }
+    return 0;
+}
+
+// ---------- Binary Tables ----------
+// Copies every table of the current building to/from its binary form
+// (<file>.bin), e.g. for a quick snapshot before bulk edits.
+//   dorm_system [--building NAME] --export-binary | --import-binary
+// A .bin that cannot be read in full (e.g. written before a field was added)
+// is reported and its text table left untouched.
+template<class T>
+bool convertTable(const string &file, bool toBinary){
+    if(!filesystem::exists(toBinary ? file : file + ".bin")) return true;
+    if(toBinary){
+        auto v = loadTable<T>(file, {});
+        if(!Table<T>::saveBinary(file + ".bin", v)){ cerr << "Could not write " << file << ".bin\n"; return false; }
+        cout << file << " -> " << file << ".bin (" << v.size() << " rows)\n";
+    }else{
+        vector<T> v; string err;
+        if(!Table<T>::loadBinary(file + ".bin", v, err)){
+            cerr << file << ".bin: " << err << "; " << file << " not changed\n";
+            return false;
+        }
+        saveTable(file, v);
+        cout << file << ".bin -> " << file << " (" << v.size() << " rows)\n";
+    }
+    return true;
+}
+bool convertTables(bool toBinary){
+    bool ok = convertTable<Room>(dataPath(ROOM_FILE), toBinary);
+    ok = convertTable<Tenant>(dataPath(TENANT_FILE), toBinary) && ok;
+    ok = convertTable<Contract>(dataPath(CONTRACT_FILE), toBinary) && ok;
+    ok = convertTable<Utility>(dataPath(UTILITY_FILE), toBinary) && ok;
+    ok = convertTable<Invoice>(dataPath(INVOICE_FILE), toBinary) && ok;
+    ok = convertTable<Payment>(dataPath(PAYMENT_FILE), toBinary) && ok;
+    Persister::instance().flush();
+    return ok;
+}
+
+// Times loading N synthetic invoices three ways: the old split()+stod
+// parser, the schema text parser, and the binary form.
+//   dorm_system --bench-parse [N]
+int ParseBenchMain(size_t n){
+    const string txt = "bench_parse.dat", bin = "bench_parse.bin";
+    vector<Invoice> rows;
+    rows.reserve(n);
+    mt19937 rng(1);
+    for(size_t i=0;i<n;++i){
+        double price = 3000 + rng() % 5000, water = (rng() % 2000) / 10.0, elec = (rng() % 8000) / 10.0;
+        rows.push_back(Invoice{"I" + to_string(i), "C" + to_string(i % 500), to_string(100 + i % 300),
+                               to_string(1 + i % 12), "2025", price, 200, water, elec, price + 200 + water + elec,
+                               i % 3 ? "PAID" : "UNPAID"});
+    }
+    Table<Invoice>::save(txt, rows);
+    Table<Invoice>::saveBinary(bin, rows);
+
+    auto time = [](auto &&fn){
+        auto start = chrono::steady_clock::now();
+        size_t got = fn();
+        return make_pair(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), got);
+    };
+    auto legacy = time([&]{
+        vector<Invoice> v;
+        ifstream f(txt);
+        string line;
+        while(getline(f, line)){
+            if(line.empty()) continue;
+            auto p = split(line);
+            if(p.size()>=11)
+                v.push_back(Invoice{p[0], p[1], p[2], p[3], p[4], stod(p[5]), stod(p[6]), stod(p[7]), stod(p[8]), stod(p[9]), p[10]});
+        }
+        return v.size();
+    });
+    auto text = time([&]{ return Table<Invoice>::load(txt, {}).size(); });
+    auto binary = time([&]{ vector<Invoice> v; string err; Table<Invoice>::loadBinary(bin, v, err); return v.size(); });
+
+    cout << "Parsing " << n << " invoices (" << filesystem::file_size(txt) << " bytes text, "
+         << filesystem::file_size(bin) << " bytes binary)\n";
+    cout << left << setw(16) << "loader" << right << setw(10) << "rows" << setw(12) << "ms" << setw(14) << "rows/s" << "\n";
+    cout << fixed << setprecision(1);
+    for(auto &r: {make_pair("split+stod", legacy), make_pair("schema text", text), make_pair("binary", binary)})
+        cout << left << setw(16) << r.first << right << setw(10) << r.second.second << setw(12) << r.second.first
+             << setw(14) << (r.second.first > 0 ? r.second.second / (r.second.first / 1000) : 0) << "\n";
+    filesystem::remove(txt);
+    filesystem::remove(bin);
+    return 0;
 }
 
 // ---------- Program Entry ----------
-int main(){
+int main(int argc, char* argv[]){
+    if(argc>1 && string(argv[1])=="--workload") return WorkloadMain(argc, argv);
+    if(argc>1 && string(argv[1])=="--bench-parse") return ParseBenchMain(argc>2 ? stoul(argv[2]) : 200000);
+    int convert = 0; // 1 = export, -1 = import
+    for(int i=1;i<argc;++i){
+        if(string(argv[i])=="--building" && i+1<argc){
+            currentBuilding = argv[++i];
+            if(!validBuildingName(currentBuilding)){ cerr << "Invalid building name: " << currentBuilding << "\n"; return 1; }
+            error_code ec;
+            filesystem::create_directories(BUILDINGS_DIR + "/" + currentBuilding, ec);
+        }
+        else if(string(argv[i])=="--export-binary") convert = 1;
+        else if(string(argv[i])=="--import-binary") convert = -1;
+    }
+    if(convert) return convertTables(convert > 0) ? 0 : 1;
     // Ensure admin exists (if none, create default admin/admin)
     vector<Admin> admins = loadAdmins();
     if(admins.empty()){
@@ -720,11 +2378,13 @@ int main(){
         saveAdmins(admins);
         cout << "Default admin created: admin / admin\n";
     }
+    CheckExpiries();
 
     while(true){
         cout << "\n========== Dormitory Management System ==========\n";
-        cout << "1) Room Management \n2) Tenant Management\n3) Contract Management\n4) Utility Calculation\n5) Invoice Calculation\n6) Payment Checking\n7) User (Tenant) View\n8) Report / Statistics\n9) AdminManagement\n0) Exit\nChoose: ";
-        int c; cin >> c;
+        cout << "Building: " << buildingLabel(currentBuilding) << "\n";
+        cout << "1) Room Management \n2) Tenant Management\n3) Contract Management\n4) Utility Calculation\n5) Invoice Calculation\n6) Payment Checking\n7) User (Tenant) View\n8) Report / Statistics\n9) AdminManagement\n10) Select Building\n11) All Buildings (group)\n12) Report in Background\n0) Exit\nChoose: ";
+        int c = readChoice();
         switch(c){
             case 1: RoomManagement(); break;
             case 2: TenantManagement(); break;
@@ -735,9 +2395,14 @@ int main(){
             case 7: UserManagement(); break;
             case 8: ReportManagement(); break;
             case 9: AdminManagement(); break;
-            case 0: cout << "Exit.\n"; return 0;
+            case 10: SelectBuilding(); break;
+            case 11: GroupManagement(); break;
+            case 12: StartBackgroundReport(); break;
+            case 0: CollectBackgroundReport(true); Persister::instance().flush(); cout << "Exit.\n"; return 0;
             default: cout << "Invalid option.\n"; break;
         }
+        CheckExpiries();
+        CollectBackgroundReport(false);
     }
     return 0;
 }
@@ -3,6 +3,14 @@
 #include <fstream>
 #include <string>
 #include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <string_view>
 
 using namespace std;
 
@@ -11,10 +19,49 @@ int menu();
 void Addstudent(string FN); // ฟังก์ชัน Addstudent เพิ่มข้อมูล
 void DisplayStudent(string FN); // ฟังก์ชัน displaystudent แสดงรายชื่อ
 void FindName(string FN); // ฟังก์ชัน findname ค้นหาชื่อ 
+void FindId(string FN); // ฟังก์ชัน findid ค้นหารหัส
+void Analytics(string FN); // ฟังก์ชัน analytics สถิติคะแนนทั้งไฟล์
+void BenchAnalytics(); // ฟังก์ชัน วัดความเร็ว analytics กับไฟล์ขนาดใหญ่
 
 
 char calGrade(int score); // ฟังก์ชัน ใช้คำนวณเกรด
 
+// ไฟล์ index ของ student.dat (เรียงตามชื่อ และ ตาม id)
+// เก็บ offset ของแต่ละแถวใน student.dat: ส่วนแรกเรียงแล้ว ส่วนท้ายคือแถวที่เพิ่งเพิ่ม
+// header = "SIDX" + ขนาด student.dat ที่ index ครอบคลุม + จำนวนแถวที่เรียงแล้ว
+enum IndexKey { BY_NAME = 0, BY_ID = 1 };
+const int PAGE_SIZE = 20; // จำนวนแถวต่อหน้าใน DisplayStudent
+
+string indexFile(string FN, IndexKey key);
+void buildIndex(string FN, IndexKey key);
+void ensureIndex(string FN, IndexKey key);
+void appendIndex(string FN, IndexKey key, uint64_t offset, uint64_t dataSize);
+vector<uint64_t> lookupIndex(string FN, IndexKey key, string value);
+
+// สถิติคะแนน: แบ่ง student.dat เป็นก้อนตามจำนวน thread แต่ละ thread นับของตัวเอง
+// (Partial) แล้วค่อยรวมกันตอนจบ
+const int TOP_N = 10; // จำนวนคนคะแนนสูงสุดที่แสดง
+const int MAX_SCORE = 100; // คะแนน 0..100 เก็บเป็น histogram ส่วนที่เกินช่วงเก็บแยก
+
+struct TopEntry {
+    int score;
+    uint64_t row; // ลำดับในไฟล์ ใช้ตัดสินเมื่อคะแนนเท่ากัน
+    string_view id, name;
+};
+
+struct Partial {
+    uint64_t count = 0;
+    double sum = 0, sumSq = 0;
+    vector<uint64_t> hist = vector<uint64_t>(MAX_SCORE + 1, 0);
+    vector<int> outside; // คะแนนนอกช่วง 0..100
+    uint64_t grades[5] = {0, 0, 0, 0, 0}; // A B C D F
+    vector<TopEntry> top; // min-heap ขนาดไม่เกิน TOP_N
+};
+
+Partial analyseChunk(string_view data, uint64_t firstRow);
+Partial analyseBuffer(const string &data, unsigned threads);
+void printAnalytics(Partial &all);
+
 int main() {
     const string filename = "student.dat"; // ข้อมูลจะเก็บที่ไฟล์ student.dat 
     ifstream infile; // การอ่าน
@@ -27,7 +74,10 @@ int main() {
         case 1: Addstudent(filename); break; // เคส 1 จะทำงาน ฟังก์ชัน addstudent
         case 2: DisplayStudent(filename); break; // เคส 2 จะทำงาน ฟังก์ชัน displaystudent
         case 3: FindName(filename); break; // เคส 3 จะทำงาน ฟังก์ชัน findname
-        default: cout << "must be 0,1,2,3 try again" << endl; // แจ้งเตือนเมื่อไม่เลือกตามเคส
+        case 4: FindId(filename); break; // เคส 4 จะทำงาน ฟังก์ชัน findid
+        case 5: Analytics(filename); break; // เคส 5 จะทำงาน ฟังก์ชัน analytics
+        case 6: BenchAnalytics(); break; // เคส 6 วัดความเร็ว analytics
+        default: cout << "must be 0,1,2,3,4,5,6 try again" << endl; // แจ้งเตือนเมื่อไม่เลือกตามเคส
         }
     } while (c!= 0);   
 
@@ -46,8 +96,11 @@ int menu() {
     cout << ": 1 - Add Student :\n";
     cout << ": 2 - Display Student :\n";
     cout << ": 3 - FindName :\n";
+    cout << ": 4 - FindId :\n";
+    cout << ": 5 - Analytics :\n";
+    cout << ": 6 - Benchmark Analytics :\n";
     cout << line << endl;
-    cout << " Enter choose : "; // ให้เลือกทำรายการ 0-3 ดังนี้
+    cout << " Enter choose : "; // ให้เลือกทำรายการ 0-6 ดังนี้
     cin >> choose; 
     return choose;
 }
@@ -65,8 +118,13 @@ void Addstudent(string FN) {
         cout << "Enter score : "; //ให้ พิมพ์ score
         cin >> score; // รับค่า score
 
+        outfile.seekp(0, ios_base::end);
+        uint64_t offset = (uint64_t)outfile.tellp(); // ตำแหน่งของแถวใหม่ ใช้ใน index
         outfile << Id << " " << Name << " " << score << endl; 
+        uint64_t dataSize = (uint64_t)outfile.tellp();
         outfile.close();
+        appendIndex(FN, BY_NAME, offset, dataSize); // เพิ่มแถวใหม่ลง index ทีละแถว
+        appendIndex(FN, BY_ID, offset, dataSize);
 
         char Wait;
         cin.get(Wait);
@@ -102,63 +160,105 @@ void DisplayStudent(string FN){
         string id,name; //สร้างตัวแปร id name
         int score; // สร้างตัวแปร score
         string line(10,'='); // สร้างตัวแปร line เส้น = มี10 เส้น
-        int n = 0; //กำหนด ตัวแปร n = 0
-        cout << "List Student\n"; 
-        cout << line << endl; // แสดงเส้น
-        cout << "No. id name score Grade" << endl; 
-        cout << line << endl; 
-        Infile >> id >> name >> score; 
-        while (!Infile.eof())
+        vector<streampos> pages; // ตำแหน่งเริ่มของแต่ละหน้า ใช้ย้อนกลับหน้าก่อน
+        pages.push_back(Infile.tellg());
+        int page = 0;
+        string cmd;
+        getline(cin, cmd); // ทิ้ง enter ที่ค้างจากเมนู
+        while (true)
         {
-            n = n + 1;
+            Infile.clear();
+            Infile.seekg(pages[page]);
+            cout << "List Student (page " << page + 1 << ")\n"; 
+            cout << line << endl; // แสดงเส้น
+            cout << "No. id name score Grade" << endl; 
+            cout << line << endl; 
+            int n = page * PAGE_SIZE; // ลำดับแถวแรกของหน้านี้
+            int shown = 0;
+            while (shown < PAGE_SIZE && Infile >> id >> name >> score)
+            {
+                n = n + 1;
+                shown = shown + 1;
 
-            // เป็นการกำหนดความห่างตัวอักษร
-        cout << right << setw(3) << n << " : ";
-        cout << left  << setw(8)  << id;            
-        cout << setw(20) << name;             
-        cout << right << setw(6)  << score;    
-        cout << setw(6)  << calGrade(score) << endl; 
+                // เป็นการกำหนดความห่างตัวอักษร
+            cout << right << setw(3) << n << " : ";
+            cout << left  << setw(8)  << id;            
+            cout << setw(20) << name;             
+            cout << right << setw(6)  << score;    
+            cout << setw(6)  << calGrade(score) << endl; 
+            }
+            bool more = shown == PAGE_SIZE && (Infile >> ws, Infile.peek() != EOF);
+            if (more && page + 1 == (int)pages.size()) pages.push_back(Infile.tellg());
 
-        Infile >> id >> name >> score;
+            cout << "[n] next  [p] prev  [q] back : ";
+            if (!getline(cin, cmd) || cmd == "q") break;
+            if (cmd == "p") { if (page > 0) page = page - 1; }
+            else if (more) page = page + 1;
+            else break; // หน้าสุดท้ายแล้ว
         }
         Infile.close();
-        char Wait;
-        cin.get(Wait);
-        cout << "Press Enter to continue";
-        cin.get(Wait);
     }else{
         cout << "File could not opened." << endl;
     }
     
 }
 
+void printFound(string FN, vector<uint64_t> offsets) {
+    ifstream Infile(FN.c_str(), ios_base::in);
+    string id, name;
+    int score;
+    for (size_t i = 0; i < offsets.size(); i++) {
+        Infile.clear();
+        Infile.seekg((streamoff)offsets[i]);
+        if (Infile >> id >> name >> score) {
+            cout << "\nFound student!\n";
+            cout << "ID: " << id << endl;
+            cout << "Name: " << name << endl;
+            cout << "Score: " << score << endl;
+            cout << "Grade: " << calGrade(score) << endl;
+        }
+    }
+}
+
 void FindName(string FN) {
     ifstream Infile(FN.c_str(), ios_base::in);
     if (Infile.is_open()) {
+        Infile.close();
         string searchName;  // กำหนด ตัวแปร 
         cout << "Enter name to find: ";
         cin >> searchName; // รับค่า ค้นหาชื่อ
 
-        string id, name;
-        int score;
-        bool found = false;
-
-        while (Infile >> id >> name >> score) {
-            if (name == searchName) {
-                cout << "\nFound student!\n";
-                cout << "ID: " << id << endl;
-                cout << "Name: " << name << endl;
-                cout << "Score: " << score << endl;
-                cout << "Grade: " << calGrade(score) << endl;
-                found = true;
-                break;
-            }
-        }
+        // ค้นหาแบบ binary search ใน index แสดงทุกคนที่ชื่อตรงกัน
+        vector<uint64_t> found = lookupIndex(FN, BY_NAME, searchName);
+        printFound(FN, found);
 
-        if (!found) {
+        if (found.empty()) {
             cout << "Student with name " << searchName << " not found.\n";  // คำสั่งนี้ ถ้าเกิดจริง จะโชว์ข้อมูลนักเรียน ถ้าไม่จริง จะโชว์ student with name not found
         }
+
+        char Wait;
+        cin.get(Wait);
+        cout << "Press Enter to continue";
+        cin.get(Wait);
+    } else {
+        cout << "File could not opened." << endl;
+    }
+}
+
+void FindId(string FN) {
+    ifstream Infile(FN.c_str(), ios_base::in);
+    if (Infile.is_open()) {
         Infile.close();
+        string searchId;
+        cout << "Enter id to find: ";
+        cin >> searchId; // รับค่า ค้นหารหัส
+
+        vector<uint64_t> found = lookupIndex(FN, BY_ID, searchId);
+        printFound(FN, found);
+
+        if (found.empty()) {
+            cout << "Student with id " << searchId << " not found.\n";
+        }
 
         char Wait;
         cin.get(Wait);
@@ -168,3 +268,374 @@ void FindName(string FN) {
         cout << "File could not opened." << endl;
     }
 }
+
+// ---------- index ของ student.dat ----------
+
+string indexFile(string FN, IndexKey key) {
+    return FN + (key == BY_NAME ? ".nameidx" : ".ididx");
+}
+
+// อ่าน key (ชื่อ หรือ id) ของแถวที่ offset
+string keyAt(ifstream &data, uint64_t offset, IndexKey key) {
+    string id, name;
+    data.clear();
+    data.seekg((streamoff)offset);
+    data >> id >> name;
+    return key == BY_NAME ? name : id;
+}
+
+uint64_t fileSize(string FN) {
+    ifstream f(FN.c_str(), ios_base::in | ios_base::binary | ios_base::ate);
+    if (!f.is_open()) return 0;
+    return (uint64_t)f.tellg();
+}
+
+// สร้าง index ใหม่ทั้งไฟล์ (ใช้ตอนไม่มี index หรือส่วนท้ายยาวเกินไป)
+void buildIndex(string FN, IndexKey key) {
+    ifstream data(FN.c_str(), ios_base::in | ios_base::binary);
+    vector<pair<string, uint64_t> > rows;
+    string row;
+    uint64_t offset = 0;
+    while (getline(data, row)) {
+        size_t a = row.find_first_not_of(" \t\r");
+        if (a != string::npos) {
+            size_t b = row.find_first_of(" \t", a);
+            size_t c = row.find_first_not_of(" \t", b);
+            size_t d = row.find_first_of(" \t\r", c);
+            string id = row.substr(a, b - a);
+            string name = c == string::npos ? "" : row.substr(c, d == string::npos ? string::npos : d - c);
+            rows.push_back(make_pair(key == BY_NAME ? name : id, offset));
+        }
+        offset += row.size() + 1;
+    }
+    stable_sort(rows.begin(), rows.end());
+
+    ofstream idx(indexFile(FN, key).c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+    uint64_t dataSize = fileSize(FN);
+    uint64_t sorted = rows.size();
+    idx.write("SIDX", 4);
+    idx.write((const char*)&dataSize, sizeof(dataSize));
+    idx.write((const char*)&sorted, sizeof(sorted));
+    for (size_t i = 0; i < rows.size(); i++) idx.write((const char*)&rows[i].second, sizeof(uint64_t));
+}
+
+const streamoff HEADER_SIZE = 4 + 2 * sizeof(uint64_t);
+
+// อ่าน header ของ index ถ้าใช้ไม่ได้ หรือไม่ตรงกับ student.dat จะคืน false
+bool readHeader(ifstream &idx, uint64_t &dataSize, uint64_t &sorted, uint64_t &total) {
+    char magic[4];
+    idx.seekg(0, ios_base::end);
+    streamoff size = idx.tellg();
+    idx.seekg(0);
+    if (!idx.read(magic, 4) || string(magic, 4) != "SIDX") return false;
+    idx.read((char*)&dataSize, sizeof(dataSize));
+    idx.read((char*)&sorted, sizeof(sorted));
+    total = (uint64_t)(size - HEADER_SIZE) / sizeof(uint64_t);
+    return (bool)idx && sorted <= total;
+}
+
+void ensureIndex(string FN, IndexKey key) {
+    ifstream idx(indexFile(FN, key).c_str(), ios_base::in | ios_base::binary);
+    uint64_t dataSize, sorted, total;
+    if (!idx.is_open() || !readHeader(idx, dataSize, sorted, total) || dataSize != fileSize(FN)) {
+        idx.close();
+        buildIndex(FN, key);
+    }
+}
+
+// เพิ่ม offset ของแถวใหม่ต่อท้าย index แล้วอัปเดตขนาดไฟล์ใน header
+void appendIndex(string FN, IndexKey key, uint64_t offset, uint64_t dataSize) {
+    uint64_t oldSize, sorted, total;
+    {
+        ifstream idx(indexFile(FN, key).c_str(), ios_base::in | ios_base::binary);
+        if (!idx.is_open() || !readHeader(idx, oldSize, sorted, total) || oldSize != offset) {
+            idx.close();
+            buildIndex(FN, key); // index เก่าไม่ตรงกับไฟล์ สร้างใหม่ (รวมแถวใหม่แล้ว)
+            return;
+        }
+    }
+    uint64_t tail = total - sorted + 1;
+    if (tail > 256 && tail > sorted / 16) {
+        buildIndex(FN, key); // ส่วนท้ายยาวเกิน รวมเข้าส่วนที่เรียงแล้ว
+        return;
+    }
+    fstream idx(indexFile(FN, key).c_str(), ios_base::in | ios_base::out | ios_base::binary);
+    idx.seekp(0, ios_base::end);
+    idx.write((const char*)&offset, sizeof(offset));
+    idx.seekp(4);
+    idx.write((const char*)&dataSize, sizeof(dataSize));
+}
+
+// binary search ส่วนที่เรียงแล้ว + ไล่ส่วนท้าย คืน offset ของทุกแถวที่ key ตรงกัน
+vector<uint64_t> lookupIndex(string FN, IndexKey key, string value) {
+    vector<uint64_t> found;
+    ensureIndex(FN, key);
+    ifstream idx(indexFile(FN, key).c_str(), ios_base::in | ios_base::binary);
+    ifstream data(FN.c_str(), ios_base::in | ios_base::binary);
+    uint64_t dataSize, sorted, total;
+    if (!readHeader(idx, dataSize, sorted, total)) return found;
+
+    uint64_t lo = 0, hi = sorted;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        uint64_t offset;
+        idx.seekg(HEADER_SIZE + (streamoff)(mid * sizeof(uint64_t)));
+        idx.read((char*)&offset, sizeof(offset));
+        if (keyAt(data, offset, key) < value) lo = mid + 1;
+        else hi = mid;
+    }
+    idx.seekg(HEADER_SIZE + (streamoff)(lo * sizeof(uint64_t)));
+    for (uint64_t i = lo; i < total; i++) {
+        uint64_t offset;
+        idx.read((char*)&offset, sizeof(offset));
+        bool match = keyAt(data, offset, key) == value;
+        if (match) found.push_back(offset);
+        else if (i < sorted) { // พ้นช่วงที่ตรงกันแล้ว ข้ามไปไล่ส่วนท้าย
+            i = sorted - 1;
+            idx.seekg(HEADER_SIZE + (streamoff)(sorted * sizeof(uint64_t)));
+        }
+    }
+    return found;
+}
+
+// ---------- สถิติคะแนน (analytics) ----------
+
+bool topLess(const TopEntry &a, const TopEntry &b) { // ใช้กับ heap: ตัวบนสุด = คนที่แย่ที่สุดใน top
+    if (a.score != b.score) return a.score > b.score;
+    return a.row < b.row;
+}
+
+void pushTop(vector<TopEntry> &top, const TopEntry &e) {
+    if ((int)top.size() < TOP_N) {
+        top.push_back(e);
+        push_heap(top.begin(), top.end(), topLess);
+    } else if (topLess(e, top.front())) {
+        pop_heap(top.begin(), top.end(), topLess);
+        top.back() = e;
+        push_heap(top.begin(), top.end(), topLess);
+    }
+}
+
+// อ่านทีละแถว "id name score" ในก้อนข้อมูล โดยไม่ copy string
+Partial analyseChunk(string_view data, uint64_t firstRow) {
+    Partial p;
+    size_t pos = 0;
+    uint64_t row = firstRow;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        if (end == string_view::npos) end = data.size();
+        string_view line = data.substr(pos, end - pos);
+        pos = end + 1;
+
+        string_view tok[3];
+        int n = 0;
+        size_t i = 0;
+        while (n < 3 && i < line.size()) {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) i++;
+            size_t b = i;
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r') i++;
+            if (i > b) tok[n++] = line.substr(b, i - b);
+        }
+        if (n < 3) continue; // แถวว่างหรือไม่ครบ
+
+        bool neg = tok[2][0] == '-';
+        int score = 0;
+        bool ok = tok[2].size() > (neg ? 1u : 0u);
+        for (size_t k = neg ? 1 : 0; k < tok[2].size() && ok; k++) {
+            if (tok[2][k] < '0' || tok[2][k] > '9') ok = false;
+            else score = score * 10 + (tok[2][k] - '0');
+        }
+        if (!ok) continue;
+        if (neg) score = -score;
+
+        p.count++;
+        p.sum += score;
+        p.sumSq += (double)score * score;
+        if (score >= 0 && score <= MAX_SCORE) p.hist[score]++;
+        else p.outside.push_back(score);
+        switch (calGrade(score)) {
+        case 'A': p.grades[0]++; break;
+        case 'B': p.grades[1]++; break;
+        case 'C': p.grades[2]++; break;
+        case 'D': p.grades[3]++; break;
+        default: p.grades[4]++;
+        }
+        pushTop(p.top, TopEntry{score, row, tok[0], tok[1]});
+        row++;
+    }
+    return p;
+}
+
+// รวมผลของอีก thread เข้ามา
+void mergePartial(Partial &into, const Partial &from) {
+    into.count += from.count;
+    into.sum += from.sum;
+    into.sumSq += from.sumSq;
+    for (int i = 0; i <= MAX_SCORE; i++) into.hist[i] += from.hist[i];
+    into.outside.insert(into.outside.end(), from.outside.begin(), from.outside.end());
+    for (int i = 0; i < 5; i++) into.grades[i] += from.grades[i];
+    for (size_t i = 0; i < from.top.size(); i++) pushTop(into.top, from.top[i]);
+}
+
+// แบ่ง buffer เป็น threads ก้อน (ตัดที่ขึ้นบรรทัดใหม่) แล้วนับพร้อมกัน
+Partial analyseBuffer(const string &data, unsigned threads) {
+    // ไฟล์เล็กไม่คุ้มแตก thread: ให้แต่ละก้อนยาวอย่างน้อย 64KB
+    threads = (unsigned)max<size_t>(1, min<size_t>(threads, data.size() / (64 * 1024)));
+    vector<size_t> cut(threads + 1);
+    cut[0] = 0;
+    cut[threads] = data.size();
+    for (unsigned i = 1; i < threads; i++) {
+        size_t p = max(cut[i - 1], data.size() * i / threads);
+        while (p > 0 && p < data.size() && data[p - 1] != '\n') p++;
+        cut[i] = p;
+    }
+    vector<Partial> parts(threads);
+    vector<thread> pool;
+    string_view all(data);
+    // ลำดับแถว (row) ใช้แค่ตัดสินคะแนนเท่ากัน จึงให้แต่ละก้อนเริ่มที่ offset ของตัวเอง
+    for (unsigned i = 1; i < threads; i++)
+        pool.push_back(thread([&, i] { parts[i] = analyseChunk(all.substr(cut[i], cut[i + 1] - cut[i]), cut[i]); }));
+    parts[0] = analyseChunk(all.substr(cut[0], cut[1] - cut[0]), 0);
+    for (size_t i = 0; i < pool.size(); i++) pool[i].join();
+    for (unsigned i = 1; i < threads; i++) mergePartial(parts[0], parts[i]);
+    return parts[0];
+}
+
+// คะแนนลำดับที่ k (เริ่ม 0) เมื่อเรียงจากน้อยไปมาก
+double scoreAt(const Partial &all, vector<int> &outside, uint64_t k) {
+    uint64_t below = 0;
+    for (size_t i = 0; i < outside.size() && outside[i] < 0; i++) {
+        if (below == k) return outside[i];
+        below++;
+    }
+    for (int s = 0; s <= MAX_SCORE; s++) {
+        if (k < below + all.hist[s]) return s;
+        below += all.hist[s];
+    }
+    size_t high = (size_t)(k - below);
+    size_t firstHigh = lower_bound(outside.begin(), outside.end(), 0) - outside.begin();
+    return outside[min(outside.size() - 1, firstHigh + high)];
+}
+
+// percentile rank = % ของคนที่ได้คะแนนน้อยกว่า + ครึ่งหนึ่งของคนที่ได้เท่ากัน
+double percentRank(const Partial &all, int score) {
+    uint64_t less = 0, equal = 0;
+    for (int s = 0; s <= MAX_SCORE; s++) {
+        if (s < score) less += all.hist[s];
+        else if (s == score) equal += all.hist[s];
+    }
+    for (size_t i = 0; i < all.outside.size(); i++) {
+        if (all.outside[i] < score) less++;
+        else if (all.outside[i] == score) equal++;
+    }
+    return 100.0 * (less + equal / 2.0) / all.count;
+}
+
+void printAnalytics(Partial &all) {
+    string line(40, '=');
+    cout << line << endl;
+    cout << "Students : " << all.count << endl;
+    if (all.count == 0) return;
+    sort(all.outside.begin(), all.outside.end());
+    double mean = all.sum / all.count;
+    double var = all.sumSq / all.count - mean * mean;
+    double median = all.count % 2 ? scoreAt(all, all.outside, all.count / 2)
+                                  : (scoreAt(all, all.outside, all.count / 2 - 1) + scoreAt(all, all.outside, all.count / 2)) / 2;
+    cout << fixed << setprecision(2);
+    cout << "Mean     : " << mean << endl;
+    cout << "Median   : " << median << endl;
+    cout << "Std.dev  : " << sqrt(max(0.0, var)) << endl;
+    cout << line << endl;
+
+    // การกระจายของเกรด
+    const char grade[5] = {'A', 'B', 'C', 'D', 'F'};
+    for (int i = 0; i < 5; i++) {
+        cout << grade[i] << " : " << right << setw(10) << all.grades[i]
+             << setw(8) << 100.0 * all.grades[i] / all.count << " %" << endl;
+    }
+    cout << line << endl;
+
+    // คะแนนที่ percentile ต่าง ๆ
+    int pct[5] = {10, 25, 50, 75, 90};
+    for (int i = 0; i < 5; i++) {
+        uint64_t k = (uint64_t)ceil(pct[i] / 100.0 * all.count);
+        cout << "P" << left << setw(3) << pct[i] << ": " << scoreAt(all, all.outside, k ? k - 1 : 0) << endl;
+    }
+    cout << line << endl;
+
+    // top-N พร้อม percentile rank
+    sort_heap(all.top.begin(), all.top.end(), topLess);
+    cout << "Top " << all.top.size() << endl;
+    for (size_t i = 0; i < all.top.size(); i++) {
+        cout << right << setw(3) << i + 1 << " : " << left << setw(8) << all.top[i].id << setw(20) << all.top[i].name
+             << right << setw(6) << all.top[i].score << setw(4) << calGrade(all.top[i].score)
+             << "  rank " << percentRank(all, all.top[i].score) << " %" << endl;
+    }
+    cout << line << endl;
+    cout.unsetf(ios_base::floatfield);
+    cout << setprecision(6);
+}
+
+bool readWhole(string FN, string &data) {
+    ifstream Infile(FN.c_str(), ios_base::in | ios_base::binary);
+    if (!Infile.is_open()) return false;
+    Infile.seekg(0, ios_base::end);
+    data.resize((size_t)Infile.tellg());
+    Infile.seekg(0);
+    Infile.read(&data[0], data.size());
+    return true;
+}
+
+void Analytics(string FN) {
+    string data;
+    if (!readWhole(FN, data)) {
+        cout << "File could not opened." << endl;
+        return;
+    }
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    Partial all = analyseBuffer(data, threads);
+    printAnalytics(all);
+
+    char Wait;
+    cin.get(Wait);
+    cout << "Press Enter to continue";
+    cin.get(Wait);
+}
+
+// สร้างไฟล์คะแนนขนาดใหญ่ แล้วจับเวลา 1 thread เทียบกับทุก thread
+void BenchAnalytics() {
+    const string benchFile = "bench_student.dat";
+    uint64_t rows;
+    cout << "Rows to generate : ";
+    cin >> rows;
+    {
+        ofstream out(benchFile.c_str(), ios_base::out | ios_base::trunc);
+        mt19937 rng(2024);
+        normal_distribution<double> dist(65, 15);
+        string buf;
+        for (uint64_t i = 0; i < rows; i++) {
+            int score = (int)round(dist(rng));
+            score = min(100, max(0, score));
+            buf += to_string(6800000 + i) + " S" + to_string(rng() % 100000) + " " + to_string(score) + "\n";
+            if (buf.size() > (1 << 20)) { out << buf; buf.clear(); }
+        }
+        out << buf;
+    }
+    string data;
+    readWhole(benchFile, data);
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    unsigned runs[2] = {1, threads};
+    for (int r = 0; r < 2; r++) {
+        auto t0 = chrono::steady_clock::now();
+        Partial all = analyseBuffer(data, runs[r]);
+        double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        cout << right << setw(3) << runs[r] << " thread(s) : " << sec << " s, "
+             << (uint64_t)(all.count / sec) << " rows/s" << endl;
+    }
+    remove(benchFile.c_str());
+
+    char Wait;
+    cin.get(Wait);
+    cout << "Press Enter to continue";
+    cin.get(Wait);
+}